@@ -26,19 +26,131 @@
  */
 #define POWER_MAGNET 13
 
+/*
+ * posizione attuale del magnete espressa in step rispetto al centro
+ * della cella A1 (X lungo le colonne A..H, Y lungo le righe 1..8):
+ * il magnete non torna piu' in A1 dopo ogni mossa, quindi la mossa
+ * successiva parte da dove si trova
+ */
+long solenoid_x = 0;
+long solenoid_y = 0;
+
+/*
+ * gli step non sono piu' generati con delayMicroseconds: i fronti
+ * dei piedini (con il tempo che li separa dal fronte successivo)
+ * vengono precalcolati in un buffer circolare, svuotato dalla
+ * interrupt del Timer1, cosi' la CPU resta libera durante i
+ * movimenti e la durata degli impulsi non dipende dal resto del
+ * codice
+ */
+#define RING_SIZE 64
+
+// livelli dei piedini impostati da un fronte
+#define OUT_X_STP 0x01
+#define OUT_Y_STP 0x02
+#define OUT_X_DIR 0x04
+#define OUT_Y_DIR 0x08
+
+struct Edge {
+  byte outputs;          // livelli di tutti i piedini dei motori
+  unsigned int ticks;    // tick del Timer1 (4 us) fino al fronte successivo
+};
+
+Edge ring[RING_SIZE];
+volatile byte ring_head = 0;  // scritto solo da step
+volatile byte ring_tail = 0;  // scritto solo dalla interrupt
+volatile boolean timer_running = false;
+
+// livelli dei piedini dopo l'ultimo fronte precalcolato
+byte outputs = 0;
+
+/*
+ * il Timer1 in modalita' CTC riparte da 0 ad ogni confronto, quindi
+ * l'intervallo successivo si conta dal fronte programmato e non da
+ * quando e' stata servita l'interrupt: il ritardo non si accumula
+ */
+ISR (TIMER1_COMPA_vect) {
+  if (ring_head == ring_tail) {
+    // non ci sono altri fronti: il timer si ferma
+    TIMSK1 &= ~(1 << OCIE1A);
+    timer_running = false;
+    return;
+  }
+  Edge edge = ring[ring_tail];
+  ring_tail = (ring_tail + 1) % RING_SIZE;
+
+  digitalWrite (X_DIR, (edge.outputs & OUT_X_DIR) ? HIGH : LOW);
+  digitalWrite (Y_DIR, (edge.outputs & OUT_Y_DIR) ? HIGH : LOW);
+  digitalWrite (X_STP, (edge.outputs & OUT_X_STP) ? HIGH : LOW);
+  digitalWrite (Y_STP, (edge.outputs & OUT_Y_STP) ? HIGH : LOW);
+
+  OCR1A = edge.ticks - 1;
+}
+
+void start_timer () {
+  noInterrupts ();
+  TCCR1A = 0;
+  // CTC, prescaler 64: un tick ogni 4 us
+  TCCR1B = (1 << WGM12) | (1 << CS11) | (1 << CS10);
+  TCNT1 = 0;
+  OCR1A = 1;
+  timer_running = true;
+  TIMSK1 |= (1 << OCIE1A);
+  interrupts ();
+}
+
+/*
+ * aggiunge un fronte al buffer, aspettando un posto libero se e'
+ * pieno (l'interrupt continua a generare gli impulsi)
+ */
+void push_edge (byte edge_outputs, unsigned long us) {
+  while ((ring_head + 1) % RING_SIZE == ring_tail) {
+  }
+  ring[ring_head].outputs = edge_outputs;
+  ring[ring_head].ticks = us / 4;
+  // il fronte deve essere scritto prima di pubblicarlo all'interrupt
+  __sync_synchronize ();
+  ring_head = (ring_head + 1) % RING_SIZE;
+
+  // l'interrupt ferma il timer solo a buffer vuoto
+  if (!timer_running) {
+    start_timer ();
+  }
+}
+
+/*
+ * aspetta che i motori abbiano eseguito tutti i fronti, prima
+ * di spegnere la CNC o il magnete
+ */
+void wait_steps () {
+  while (timer_running) {
+  }
+}
+
 /*
 // Function : step . function: to control the direction of the stepper motor , the number of steps .
 // Parameters : dir direction control , dirPin corresponding stepper motor DIR pin , stepperPin corresponding stepper motor " step " pin , Step number of step of no return value.
 */
 void step (boolean dir, byte dirPin, byte stepperPin, int steps)
 {
-  digitalWrite (dirPin, dir);
-  delay (50);
+  byte dir_bit = dirPin == X_DIR ? OUT_X_DIR : OUT_Y_DIR;
+  byte step_bit = stepperPin == X_STP ? OUT_X_STP : OUT_Y_STP;
+
+  // tiene traccia della posizione del magnete
+  if (dirPin == X_DIR) {
+    // dir = true sposta il magnete verso la colonna H
+    solenoid_x += dir ? steps : -steps;
+  } else {
+    // dir = true sposta il magnete verso la riga 1
+    solenoid_y += dir ? -steps : steps;
+  }
+
+  // cambio di direzione e poi un impulso (alto e basso) per ogni step
+  outputs = dir ? outputs | dir_bit : outputs & ~dir_bit;
+  push_edge (outputs, 50000L);
   for (int i = 0; i < steps; i++) {
-    digitalWrite (stepperPin, HIGH);
-    delayMicroseconds (800);
-    digitalWrite (stepperPin, LOW);
-    delayMicroseconds (800);
+    push_edge (outputs | step_bit, 800);
+    push_edge (outputs, 800);
   }
 }
 
@@ -85,6 +197,7 @@ bool navigate (char * from, char * to) {
   }
 
   // wait the CNC to finish
+  wait_steps();
   delay(500);
 
   //power off the magnet
@@ -99,9 +212,18 @@ bool navigate (char * from, char * to) {
 /*
  * questa funzione serve per muoversi quando il magnete è spento
  * perchè evita di fare le diagonali e non fa controlli riguardo
- * delta_x e delta_y
+ * delta_x e delta_y: parte dalla posizione attuale del magnete
  */
-void direct  (char * from, char * to) {
+void direct  (char * to) {
+
+  // es: da A1 (posizione attuale) a C3
+  long target_x = (to[0] - 'A') * (long) STEPS;
+  long target_y = (to[1] - '1') * (long) STEPS;
+
+  // il magnete e' gia' in posizione
+  if (target_x == solenoid_x && target_y == solenoid_y) {
+    return;
+  }
 
   // power up the CNC board
   digitalWrite (POWER_CNC, HIGH);
@@ -110,17 +232,18 @@ void direct  (char * from, char * to) {
   delay(1000);
   
   // es: navigate from A1 to C3
-  bool dir_x = to[0] > from[0]; // es: C > A --> true
-  bool dir_y = to[1] < from[1]; // es: 3 > 1 --> true
+  bool dir_x = target_x > solenoid_x; // es: C > A --> true
+  bool dir_y = target_y < solenoid_y; // es: 3 > 1 --> true
 
   // es: navigate from A1 to C3
-  int delta_x = abs(to[0] - from[0]);  // es: C - A = 2
-  int delta_y = abs(to[1] - from[1]);  // es: 3 - 1 = 2
+  long delta_x = labs(target_x - solenoid_x);  // es: (C - A) * STEPS
+  long delta_y = labs(target_y - solenoid_y);  // es: (3 - 1) * STEPS
 
-  step (dir_x, X_DIR, X_STP, STEPS * delta_x);
-  step (dir_y, Y_DIR, Y_STP, STEPS * delta_y);
+  step (dir_x, X_DIR, X_STP, delta_x);
+  step (dir_y, Y_DIR, Y_STP, delta_y);
 
   // wait the CNC to finish
+  wait_steps();
   delay(500);
 
   //power off the CNC board
@@ -130,22 +253,21 @@ void direct  (char * from, char * to) {
 
 /*
  * questa è la funzione che fa tutto:
- * - manda il magnete in posizione
+ * - manda il magnete in posizione partendo da dove si trova
  * - lo accende
  * - sposta la pendina a destinazione
  * - spegne il magnete
- * - riporta il magnete al punto di partenza
  * 
+ * NB: il magnete resta sulla cella di destinazione (o su quella
+ * di partenza in caso di errore) e la mossa successiva parte da li',
+ * senza il viaggio di ritorno in A1
+ *
  * NB: si muove solo in orizzontale/verticale/diagonale
  * la mossa del cavallo non è ancora stata implementata
  */
 void move (char * from, char * to) {
-  direct("A1", from);
-  if (navigate(from, to) == true) {
-    direct(to, "A1");
-  } else {
-    direct(from, "A1");
-  }
+  direct(from);
+  navigate(from, to);
 }
 
 void setup () {
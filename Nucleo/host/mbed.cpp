@@ -0,0 +1,261 @@
+/*
+ * Stub of the mbed API: virtual clock, scripted button presses and counters of the output edges.
+ */
+
+#include "mbed.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_PRESSES 256
+#define MAX_TIMEOUTS 8
+
+static const char * pinNames[PIN_COUNT] = {"D2", "D3", "D5", "D6", "D8", "PC_4", "PC_8", "PB_12", "PB_13", "PB_14", "PB_15"};
+
+// Virtual time (us)
+static unsigned long long now = 0;
+// Rising edges counted on any output
+static unsigned long rises[PIN_COUNT];
+static InterruptIn * buttons[PIN_COUNT];
+static Timeout * timeouts[MAX_TIMEOUTS];
+static int numTimeouts = 0;
+
+// Button presses read from the standard input (time in us)
+static unsigned long long pressTimes[MAX_PRESSES];
+static PinName pressPins[MAX_PRESSES];
+static int numPresses = -1;
+static int nextPress = 0;
+
+static void loadPresses()
+{
+    unsigned long ms;
+    char name[16];
+
+    numPresses = 0;
+    while (numPresses < MAX_PRESSES && scanf("%lu %15s", &ms, name) == 2) {
+        for (int i = 0; i < PIN_COUNT; i++) {
+            if (strcmp(name, pinNames[i]) == 0) {
+                pressTimes[numPresses] = ms * 1000ULL;
+                pressPins[numPresses] = (PinName) i;
+                numPresses++;
+            }
+        }
+    }
+}
+
+// Fire the first event due within the limit, returning false if there is none
+static bool fireNext(unsigned long long limit)
+{
+    Timeout * timeout = NULL;
+
+    if (numPresses < 0) {
+        loadPresses();
+    }
+    for (int i = 0; i < numTimeouts; i++) {
+        if (timeouts[i]->isArmed() && (timeout == NULL || timeouts[i]->getDue() < timeout->getDue())) {
+            timeout = timeouts[i];
+        }
+    }
+
+    if (nextPress < numPresses && pressTimes[nextPress] <= limit &&
+        (timeout == NULL || pressTimes[nextPress] < timeout->getDue())) {
+        PinName pin = pressPins[nextPress];
+        if (pressTimes[nextPress] > now) {
+            now = pressTimes[nextPress];
+        }
+        nextPress++;
+        if (buttons[pin] != NULL) {
+            buttons[pin]->press();
+        }
+        return true;
+    }
+    if (timeout != NULL && timeout->getDue() <= limit) {
+        if (timeout->getDue() > now) {
+            now = timeout->getDue();
+        }
+        timeout->expire();
+        return true;
+    }
+    return false;
+}
+
+static void advance(unsigned long long us)
+{
+    unsigned long long limit = now + us;
+
+    while (fireNext(limit)) {
+    }
+    now = limit;
+}
+
+DigitalOut::DigitalOut(PinName pin)
+{
+    this->pin = pin;
+    value = 0;
+}
+
+DigitalOut & DigitalOut::operator= (int value)
+{
+    if (value && !this->value) {
+        rises[pin]++;
+    }
+    this->value = value ? 1 : 0;
+    return *this;
+}
+
+DigitalOut::operator int()
+{
+    return value;
+}
+
+InterruptIn::InterruptIn(PinName pin)
+{
+    handler = NULL;
+    buttons[pin] = this;
+}
+
+void InterruptIn::mode(PinMode)
+{
+}
+
+void InterruptIn::fall(void (*handler)())
+{
+    this->handler = handler;
+}
+
+void InterruptIn::press()
+{
+    if (handler != NULL) {
+        handler();
+    }
+}
+
+Timer::Timer()
+{
+    origin = 0;
+    elapsed = 0;
+    running = false;
+}
+
+void Timer::start()
+{
+    if (!running) {
+        origin = now;
+        running = true;
+    }
+}
+
+void Timer::stop()
+{
+    if (running) {
+        elapsed += now - origin;
+        running = false;
+    }
+}
+
+void Timer::reset()
+{
+    origin = now;
+    elapsed = 0;
+}
+
+int Timer::read_us()
+{
+    return (int) (elapsed + (running ? now - origin : 0));
+}
+
+int Timer::read_ms()
+{
+    return read_us() / 1000;
+}
+
+float Timer::read()
+{
+    return read_us() / 1000000.0f;
+}
+
+Timeout::Timeout()
+{
+    handler = NULL;
+    due = 0;
+    armed = false;
+    if (numTimeouts < MAX_TIMEOUTS) {
+        timeouts[numTimeouts++] = this;
+    }
+}
+
+void Timeout::attach_us(void (*handler)(), int us)
+{
+    this->handler = handler;
+    due = now + (us > 0 ? us : 0);
+    armed = true;
+}
+
+void Timeout::detach()
+{
+    armed = false;
+}
+
+void Timeout::expire()
+{
+    // the handler may attach the timeout again
+    armed = false;
+    handler();
+}
+
+unsigned long long Timeout::getDue()
+{
+    return due;
+}
+
+bool Timeout::isArmed()
+{
+    return armed;
+}
+
+void wait(float s)
+{
+    advance((unsigned long long) (s * 1000000));
+}
+
+void wait_ms(int ms)
+{
+    advance(ms * 1000ULL);
+}
+
+void wait_us(int us)
+{
+    advance(us);
+}
+
+void __DMB()
+{
+    __sync_synchronize();
+}
+
+void __disable_irq()
+{
+}
+
+void __enable_irq()
+{
+}
+
+void __WFI()
+{
+    // the handler of the interrupt runs at once, on the board it runs when the interrupts are unmasked
+    sleep();
+}
+
+void sleep()
+{
+    // the processor wakes up at the next interrupt, the program is over when there are no more events
+    if (!fireNext((unsigned long long) -1)) {
+        printf("\n%llu us elapsed\n", now);
+        for (int i = 0; i < PIN_COUNT; i++) {
+            if (rises[i] > 0) {
+                printf("%s : %lu rising edges\n", pinNames[i], rises[i]);
+            }
+        }
+        exit(0);
+    }
+}
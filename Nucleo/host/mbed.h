@@ -0,0 +1,87 @@
+/*
+ * Stub of the mbed API used by Nucleo/main.cpp, to run the jog executor on the host against a virtual clock:
+ *
+ *      g++ -I Nucleo/host -o nucleo Nucleo/main.cpp Nucleo/host/mbed.cpp
+ *      ./nucleo < presses.txt
+ *
+ * Any line of the standard input is a button press: the time (ms) and the pin of the button (es: "120 PB_14").
+ * The interrupts are fired while the program waits or sleeps, when no event is left the stub prints the
+ * elapsed time and the rising edges counted on any output, then it exits.
+ */
+
+#ifndef MBED_H
+#define MBED_H
+
+#include <stdio.h>
+
+enum PinName { D2, D3, D5, D6, D8, PC_4, PC_8, PB_12, PB_13, PB_14, PB_15, PIN_COUNT };
+
+enum PinMode { PullUp, PullDown, PullNone };
+
+class DigitalOut {
+    public:
+        DigitalOut(PinName pin);
+        DigitalOut & operator= (int value);
+        operator int();
+
+    private:
+        PinName pin;
+        int value;
+};
+
+class InterruptIn {
+    public:
+        InterruptIn(PinName pin);
+        void mode(PinMode pull);
+        void fall(void (*handler)());
+        // Called by the stub when a press of the button is due
+        void press();
+
+    private:
+        void (*handler)();
+};
+
+class Timer {
+    public:
+        Timer();
+        void start();
+        void stop();
+        void reset();
+        int read_us();
+        int read_ms();
+        float read();
+
+    private:
+        unsigned long long origin;
+        unsigned long long elapsed;
+        bool running;
+};
+
+class Timeout {
+    public:
+        Timeout();
+        void attach_us(void (*handler)(), int us);
+        void detach();
+        // Called by the stub when the timeout is due
+        void expire();
+        unsigned long long getDue();
+        bool isArmed();
+
+    private:
+        void (*handler)();
+        unsigned long long due;
+        bool armed;
+};
+
+void wait(float s);
+void wait_ms(int ms);
+void wait_us(int us);
+void sleep();
+// Memory barrier: the writes before it are completed before the ones after it
+void __DMB();
+// Mask and unmask the interrupts, wait for an interrupt (also a masked one, that runs when it is unmasked)
+void __disable_irq();
+void __enable_irq();
+void __WFI();
+
+#endif
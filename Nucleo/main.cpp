@@ -16,61 +16,193 @@ InterruptIn btn_down(PB_13);
 InterruptIn btn_right(PB_14);
 InterruptIn btn_left(PB_15);
 
-void step (bool dir, DigitalOut dirPin, DigitalOut stepperPin, int steps)
+// Edges precomputed ahead of the timer interrupt
+#define RING_SIZE 512
+
+// Jog requests waiting for the executor
+#define JOG_SIZE 16
+
+// Directions of a jog
+#define JOG_UP 0
+#define JOG_DOWN 1
+#define JOG_RIGHT 2
+#define JOG_LEFT 3
+
+// Half period (us) of the step pulses at the start and at the end of a jog, at full speed and the steps of the ramp
+#define START_DELAY 800
+#define MIN_DELAY 400
+#define RAMP_STEPS 100
+
+// Outputs driven by an edge
+#define OUT_X_STP 0x01
+#define OUT_Y_STP 0x02
+#define OUT_X_DIR 0x04
+#define OUT_Y_DIR 0x08
+#define OUT_CNC 0x10
+#define OUT_MAGNET 0x20
+
+// Levels of all the outputs and time (us) to the next edge
+struct Edge {
+    unsigned char outputs;
+    unsigned int interval;
+};
+
+Edge ring[RING_SIZE];
+volatile int ringHead = 0;
+volatile int ringTail = 0;
+volatile bool timerRunning = false;
+
+Timer stepClock;
+Timeout stepTimer;
+// Time (us of stepClock) of the edge being executed
+unsigned int deadline = 0;
+// Levels of the outputs after the last precomputed edge
+unsigned char outputs = 0;
+
+void stepInterrupt()
 {
-    dirPin = dir;
-    wait_ms(50);
-    for (int i = 0; i < steps; i++) {
-        stepperPin = true;
-        wait_us(800);
-        stepperPin = false;
-        wait_us(800);
+    if (ringHead == ringTail) {
+        timerRunning = false;
+        return;
     }
+    Edge edge = ring[ringTail];
+    ringTail = (ringTail + 1) % RING_SIZE;
+
+    X_DIR = (edge.outputs & OUT_X_DIR) != 0;
+    Y_DIR = (edge.outputs & OUT_Y_DIR) != 0;
+    X_STP = (edge.outputs & OUT_X_STP) != 0;
+    Y_STP = (edge.outputs & OUT_Y_STP) != 0;
+    POWER_CNC = (edge.outputs & OUT_CNC) != 0;
+    POWER_MAGNET = (edge.outputs & OUT_MAGNET) != 0;
+
+    // the next edge is counted from the deadline of this one, so the latency of the interrupt does not accumulate
+    deadline += edge.interval;
+    int delay = (int) (deadline - stepClock.read_us());
+    stepTimer.attach_us(&stepInterrupt, delay > 0 ? delay : 0);
 }
 
-void right()
+int ringFree()
 {
-    POWER_CNC = true;
-    POWER_MAGNET = true;
-    wait(0.6);
-    step(true, X_DIR, X_STP, STEPS);
-    POWER_MAGNET = false;
-    POWER_CNC = false;
+    return (ringTail - ringHead - 1 + RING_SIZE) % RING_SIZE;
 }
 
-void left()
+void startTimer()
 {
-    POWER_CNC = true;
-    POWER_MAGNET = true;
-    wait(0.6);
-    step(false, X_DIR, X_STP, STEPS);
-    POWER_MAGNET = false;
-    POWER_CNC = false;
+    // the interrupt stops the timer only when the ring buffer is empty
+    if (!timerRunning) {
+        timerRunning = true;
+        deadline = stepClock.read_us();
+        stepTimer.attach_us(&stepInterrupt, 0);
+    }
+}
+
+// Append an edge, waiting for the timer interrupt to free a place
+void pushEdge(unsigned char edgeOutputs, unsigned int interval)
+{
+    while (ringFree() == 0) {
+        sleep();
+    }
+    ring[ringHead].outputs = edgeOutputs;
+    ring[ringHead].interval = interval;
+    // the edge must be written before it is published to the timer interrupt
+    __DMB();
+    ringHead = (ringHead + 1) % RING_SIZE;
+    outputs = edgeOutputs;
+    startTimer();
+}
+
+// Half period of a step: linear ramp from START_DELAY to MIN_DELAY and back in the last RAMP_STEPS steps
+unsigned int stepDelay(int i, int steps)
+{
+    int fromEdge = i < steps - 1 - i ? i : steps - 1 - i;
+    int delay = START_DELAY - fromEdge * (START_DELAY - MIN_DELAY) / RAMP_STEPS;
+
+    return delay > MIN_DELAY ? delay : MIN_DELAY;
+}
+
+// Precompute the edges of a move: power up, direction, two edges for each step, power down
+void step (bool dir, unsigned char dirOutput, unsigned char stepOutput, int steps)
+{
+    unsigned char direction = dir ? (outputs | dirOutput) : (outputs & ~dirOutput);
+
+    pushEdge(direction | OUT_CNC | OUT_MAGNET, 600000);
+    pushEdge(outputs, 50000);
+    for (int i = 0; i < steps; i++) {
+        unsigned int delay = stepDelay(i, steps);
+        pushEdge(outputs | stepOutput, delay);
+        pushEdge(outputs & ~stepOutput, delay);
+    }
+    pushEdge(outputs & ~(OUT_CNC | OUT_MAGNET), 800);
+}
+
+volatile unsigned char jogs[JOG_SIZE];
+volatile int jogHead = 0;
+volatile int jogTail = 0;
+
+// Called by the button interrupts: a press is dropped only if JOG_SIZE presses are already waiting
+void pushJog(unsigned char direction)
+{
+    int next = (jogHead + 1) % JOG_SIZE;
+
+    if (next == jogTail) {
+        return;
+    }
+    jogs[jogHead] = direction;
+    jogHead = next;
 }
 
 void up()
 {
-    POWER_CNC = true;
-    POWER_MAGNET = true;
-    wait(0.6);
-    step(false, Y_DIR, Y_STP, STEPS);
-    POWER_MAGNET = false;
-    POWER_CNC = false;
+    pushJog(JOG_UP);
 }
 
 void down()
 {
-    POWER_CNC = true;
-    POWER_MAGNET = true;
-    wait(0.6);
-    step(true, Y_DIR, Y_STP, STEPS);
-    POWER_MAGNET = false;
-    POWER_CNC = false;
+    pushJog(JOG_DOWN);
+}
+
+void right()
+{
+    pushJog(JOG_RIGHT);
+}
+
+void left()
+{
+    pushJog(JOG_LEFT);
+}
+
+// Execute the next jog, merging the following presses in the same direction into a single longer move
+bool executeJog()
+{
+    const char * names[4] = {"up", "down", "right", "left"};
+
+    if (jogTail == jogHead) {
+        return false;
+    }
+    unsigned char direction = jogs[jogTail];
+    int presses = 0;
+    while (jogTail != jogHead && jogs[jogTail] == direction) {
+        jogTail = (jogTail + 1) % JOG_SIZE;
+        presses++;
+    }
+
+    printf("jog %s: %d presses, %d steps\n", names[direction], presses, presses * STEPS);
+    if (direction == JOG_UP) {
+        step(false, OUT_Y_DIR, OUT_Y_STP, presses * STEPS);
+    } else if (direction == JOG_DOWN) {
+        step(true, OUT_Y_DIR, OUT_Y_STP, presses * STEPS);
+    } else if (direction == JOG_RIGHT) {
+        step(true, OUT_X_DIR, OUT_X_STP, presses * STEPS);
+    } else {
+        step(false, OUT_X_DIR, OUT_X_STP, presses * STEPS);
+    }
+    return true;
 }
 
 int main() {
 
     EN = false;
+    stepClock.start();
     POWER_MAGNET = false;
     POWER_CNC = false;
     
@@ -85,4 +217,18 @@ int main() {
     
     btn_left.mode(PullUp);
     btn_left.fall(&left);
-}
\ No newline at end of file
+
+    while (true) {
+        // the presses that arrive while a move is running are merged when the move is over. The check and the
+        // sleep are done with the interrupts masked: a press in between still wakes up __WFI (its handler runs
+        // at __enable_irq), instead of waiting for an unrelated interrupt
+        __disable_irq();
+        if (timerRunning || jogTail == jogHead) {
+            __WFI();
+            __enable_irq();
+        } else {
+            __enable_irq();
+            executeJog();
+        }
+    }
+}
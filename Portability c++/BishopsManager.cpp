@@ -89,7 +89,7 @@ char * BishopsManager::checkCandidates(Cell * cbState[][8], bool turn, const cha
               }
               setNewPosition(turn, from, destination);
               candidate = new char[3];
-              for(int i = 0; i<strlen(from);i++){
+              for(int i = 0; i<=strlen(from);i++){
                   candidate[i] = from[i];
               }
               return candidate;
@@ -175,11 +175,39 @@ void BishopsManager::toString(){
 
 void BishopsManager::findAndRemove(bool turn, const char * destination){
   for(int i = 0; i < 2; i++){
-    if(strcmp(bishops[turn][i].getPosition(),destination) == 0){
-      bishops[turn][i].setAlive();
-      bishops[turn][i].setPosition("Z9");
+    if(strcmp(bishops[!turn][i].getPosition(),destination) == 0){
+      bishops[!turn][i].setAlive();
+      bishops[!turn][i].setPosition("Z9");
 
       return;
     }
   }
 };
+
+bool BishopsManager::revive(bool turn, const char * destination){
+  for(int i = 0; i < 2; i++){
+    if(!bishops[turn][i].getAlive()){
+      bishops[turn][i].setAlive();
+      bishops[turn][i].setPosition(destination);
+
+      return true;
+    }
+  }
+  return false;
+};
+
+// SetUp implementation
+bool BishopsManager::setUp(bool turn, char positions[][3], int count){
+  if(count > 2){
+    return false;
+  }
+
+  for(int i = 0; i < 2; i++){
+    if(i < count){
+      bishops[turn][i] = Bishop(positions[i]);
+    } else if(bishops[turn][i].getAlive()){
+      bishops[turn][i].setAlive();
+    }
+  }
+  return true;
+};
@@ -0,0 +1,53 @@
+/*
+ * Header file for the Block structure.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BLOCK_H
+#define BLOCK_H
+
+// Types of the blocks
+#define BLOCK_MOVE 0
+#define BLOCK_RELAY 1
+#define BLOCK_WAIT 2
+#define BLOCK_END 3
+
+// Stepper motors moved by a BLOCK_MOVE (both for a diagonal)
+#define MOVE_X 1
+#define MOVE_Y 2
+
+/**
+ * Block variables
+ *
+ * type   : BLOCK_MOVE (movement of the stepper motors), BLOCK_RELAY (switch of a relay), BLOCK_WAIT (wait of
+ *          the CNC board) or BLOCK_END (end of a sequence)
+ * target : the stepper motors of a BLOCK_MOVE (MOVE_X, MOVE_Y or both) or the pin of a BLOCK_RELAY
+ * dirX   : the direction of the X stepper motor (true = toward the H column), or true to switch a relay on
+ * dirY   : the direction of the Y stepper motor (true = toward the 1 row)
+ * count  : the steps of a BLOCK_MOVE, the time (ms) of a BLOCK_WAIT, the estimated time (ms) of a BLOCK_END
+ *          (-1 if it is not known)
+ * name   : the name of the sequence closed by a BLOCK_END
+ */
+struct Block {
+    unsigned char type;
+    unsigned char target;
+    bool dirX;
+    bool dirY;
+    long count;
+    const char * name;
+};
+
+#endif
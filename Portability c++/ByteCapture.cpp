@@ -0,0 +1,99 @@
+/*
+ * ByteCapture class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ByteCapture.h"
+#include <string.h>
+#include <time.h>
+
+using namespace std;
+
+/*
+ * Layout of a record (little endian):
+ *  0-7 : time (us) since the capture was opened
+ *  8   : number of bytes
+ *  9-  : the received bytes
+ */
+
+// Current time (us) of the monotonic clock
+static unsigned long long micros(){
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
+
+// Constructor
+ByteCapture::ByteCapture(){
+  file = NULL;
+  start = 0;
+};
+
+bool ByteCapture::open(const char * path){
+  file = fopen(path, "wb");
+  if(file == NULL){
+    return false;
+  }
+  fwrite(CAPTURE_MAGIC, 1, 4, file);
+  start = micros();
+  return true;
+};
+
+bool ByteCapture::isOpen(){
+  return file != NULL;
+};
+
+void ByteCapture::append(const char * bytes, int length){
+  unsigned char header[9];
+  unsigned long long time = micros() - start;
+
+  if(file == NULL){
+    return;
+  }
+  for(int i = 0; i < 8; i++){
+    header[i] = (time >> (8 * i)) & 0xFF;
+  }
+  while(length > 0){
+    int chunk = length > CAPTURE_CHUNK_SIZE ? CAPTURE_CHUNK_SIZE : length;
+    header[8] = chunk;
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(bytes, 1, chunk, file);
+    bytes += chunk;
+    length -= chunk;
+  }
+  fflush(file);
+};
+
+bool ByteCapture::readHeader(FILE * file){
+  char magic[4];
+
+  return fread(magic, 1, 4, file) == 4 && memcmp(magic, CAPTURE_MAGIC, 4) == 0;
+};
+
+bool ByteCapture::readRecord(FILE * file, CaptureRecord * record){
+  unsigned char header[9];
+
+  if(fread(header, 1, sizeof(header), file) != sizeof(header)){
+    return false;
+  }
+  record->time = 0;
+  for(int i = 7; i >= 0; i--){
+    record->time = (record->time << 8) | header[i];
+  }
+  record->length = header[8];
+  return fread(record->bytes, 1, record->length, file) == (size_t) record->length;
+};
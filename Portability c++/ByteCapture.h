@@ -0,0 +1,112 @@
+/*
+ * Header file for the ByteCapture class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BYTECAPTURE_H
+#define BYTECAPTURE_H
+
+#include <stdio.h>
+
+// First bytes of a capture file (the last one is the version of the format)
+#define CAPTURE_MAGIC "WCB1"
+
+// Largest number of bytes kept in a record (the longer chunks are split)
+#define CAPTURE_CHUNK_SIZE 255
+
+/**
+ * CaptureRecord variables
+ *
+ * time   : the time (us) when the bytes have been received, since the capture was opened
+ * length : the number of received bytes
+ * bytes  : the received bytes
+ */
+struct CaptureRecord {
+    unsigned long long time;
+    int length;
+    char bytes[CAPTURE_CHUNK_SIZE];
+};
+
+class ByteCapture {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with no file open
+         */
+        ByteCapture();
+
+        /**
+         * Create a capture file (an existing one is overwritten) and write its header: the times of the records
+         * start from now
+         *
+         * - Parameters :
+         *      - path : the path of the file
+         *
+         * - Return : false if the file cannot be created
+         */
+        bool open(const char * path);
+
+        /**
+         * Verify if the received bytes are being recorded
+         *
+         * - Return : true if a capture file is open
+         */
+        bool isOpen();
+
+        /**
+         * Append the bytes just received, with the current time. The file is flushed at any record, so the
+         * capture keeps all the bytes received before the program was stopped
+         *
+         * - Parameters :
+         *      - bytes  : the received bytes
+         *      - length : the number of bytes
+         */
+        void append(const char * bytes, int length);
+
+        /**
+         * Verify the header of a capture file opened for reading
+         *
+         * - Parameters :
+         *      - file : the capture file, at its start
+         *
+         * - Return : false if the file is not a capture
+         */
+        static bool readHeader(FILE * file);
+
+        /**
+         * Read the next record of a capture file
+         *
+         * - Parameters :
+         *      - file   : the capture file, after the header
+         *      - record : filled with the record
+         *
+         * - Return : false at the end of the file (or if the last record is truncated)
+         */
+        static bool readRecord(FILE * file, CaptureRecord * record);
+
+    private:
+        /**
+         * Private variables
+         *
+         * file  : the capture file being written, NULL if the bytes are not recorded
+         * start : the time (us) when the capture file has been created
+         */
+        FILE * file;
+        unsigned long long start;
+};
+
+#endif
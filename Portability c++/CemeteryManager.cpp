@@ -0,0 +1,126 @@
+/*
+ * CemeteryManager class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CemeteryManager.h"
+#include "PathPlanner.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace std;
+
+// Types of piece in the order of their index in the masks
+static const char pieceTypes[6] = {'P', 'R', 'B', 'H', 'Q', 'K'};
+
+// Spaces reserved to any type of piece (the space i is in the column i / 8 from the chessboard, in the row i % 8):
+// the white pawns are promoted in the 8 row, the black pawns in the 1 row
+static const unsigned short reserved[2][6] = {{0xFF01, 0x0060, 0x0018, 0x0006, 0x0080, 0x0000},
+                                              {0xFF80, 0x0006, 0x0018, 0x0060, 0x0001, 0x0000}};
+
+// Constructor
+CemeteryManager::CemeteryManager(){
+  for(int color = WHITE; color <= BLACK; color++){
+    occupancy[color] = 0;
+    for(int i = 0; i < 6; i++){
+      types[color][i] = 0;
+    }
+  }
+};
+
+unsigned short CemeteryManager::getCandidates(bool color, char piece){
+  unsigned short freeSpaces = ~occupancy[color];
+  unsigned short candidates = freeSpaces & reserved[color][typeIndex(piece)];
+
+  if(candidates == 0){
+    candidates = freeSpaces;
+  }
+  return candidates;
+};
+
+int CemeteryManager::findPiece(bool color, char piece, int x, int y){
+  return nearest(color, types[color][typeIndex(piece)], x, y);
+};
+
+void CemeteryManager::place(bool color, int slot, char piece){
+  occupancy[color] |= 1 << slot;
+  types[color][typeIndex(piece)] |= 1 << slot;
+};
+
+void CemeteryManager::remove(bool color, int slot){
+  occupancy[color] &= ~(1 << slot);
+  for(int i = 0; i < 6; i++){
+    types[color][i] &= ~(1 << slot);
+  }
+};
+
+char CemeteryManager::getPiece(bool color, int slot){
+  for(int i = 0; i < 6; i++){
+    if((types[color][i] >> slot) & 1){
+      return pieceTypes[i];
+    }
+  }
+  return 'E';
+};
+
+unsigned short CemeteryManager::getOccupancy(bool color){
+  return occupancy[color];
+};
+
+void CemeteryManager::toString(){
+  printf("\n\n--- Cemeteries ---\n\n");
+
+  for(int color = WHITE; color <= BLACK; color++){
+    if(color == WHITE){
+      printf("White: ");
+    } else{
+      printf("\nBlack: ");
+    }
+    for(int slot = 0; slot < CEMETERY_SLOTS; slot++){
+      printf("%c", getPiece(color, slot));
+    }
+    printf("\n");
+  }
+};
+
+int CemeteryManager::typeIndex(char piece){
+  for(int i = 0; i < 5; i++){
+    if(pieceTypes[i] == piece){
+      return i;
+    }
+  }
+  return 5;
+};
+
+int CemeteryManager::nearest(bool color, unsigned short mask, int x, int y){
+  int slot = -1;
+  int bestDistance = 0;
+
+  for(int i = 0; mask != 0; i++, mask >>= 1){
+    if(mask & 1){
+      int slotX;
+      int slotY;
+      PathPlanner::cemeteryCell(color, i, &slotX, &slotY);
+      // the two stepper motors move together, so the travel time depends on the longest axis
+      int distance = abs(slotX - x) > abs(slotY - y) ? abs(slotX - x) : abs(slotY - y);
+      if(slot < 0 || distance < bestDistance){
+        slot = i;
+        bestDistance = distance;
+      }
+    }
+  }
+  return slot;
+};
@@ -0,0 +1,144 @@
+/*
+ * Header file for the CemeteryManager class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CEMETERYMANAGER_H
+#define CEMETERYMANAGER_H
+
+// Number of spaces of any cemetery
+#define CEMETERY_SLOTS 16
+
+class CemeteryManager {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with all the spaces free
+         */
+        CemeteryManager();
+
+        /**
+         * Find the spaces where a captured piece should be placed: the free spaces reserved to its type or, if
+         * all of them are busy (e.g. a captured promoted piece), any free space of the cemetery.
+         * The queen, the rooks, the bishops and the knights are reserved the column next to the chessboard, near
+         * the row where the pawns of their color are promoted, while the pawns fill the outer column
+         *
+         * - Parameters :
+         *      - color : the color of the captured piece (WHITE or BLACK)
+         *      - piece : the type of the captured piece ('P', 'R', 'B', 'H', 'Q')
+         *
+         * - Return : the mask of the candidate spaces (bit i = space i), 0 if the cemetery is full
+         */
+        unsigned short getCandidates(bool color, char piece);
+
+        /**
+         * Find the space holding a piece of a given type that is the nearest one to a cell (e.g. the queen
+         * for a promotion)
+         * N.B.: the pieces of a type lie in the spaces reserved to it, so only a couple of spaces are checked
+         *
+         * - Parameters :
+         *      - color : the color of the piece (WHITE or BLACK)
+         *      - piece : the type of the piece ('P', 'R', 'B', 'H', 'Q')
+         *      - x     : the column of the cell (0 is the A column)
+         *      - y     : the row of the cell (0 is the 1 row)
+         *
+         * - Return : the index of the space (0 - 15), -1 if there is not a piece of that type
+         */
+        int findPiece(bool color, char piece, int x, int y);
+
+        /**
+         * Place a piece in a space
+         *
+         * - Parameters :
+         *      - color : the color of the piece (WHITE or BLACK)
+         *      - slot  : the index of the space (0 - 15)
+         *      - piece : the type of the piece
+         */
+        void place(bool color, int slot, char piece);
+
+        /**
+         * Take a piece away from a space
+         *
+         * - Parameters :
+         *      - color : the color of the piece (WHITE or BLACK)
+         *      - slot  : the index of the space (0 - 15)
+         */
+        void remove(bool color, int slot);
+
+        /**
+         * Find the type of the piece lying in a space
+         *
+         * - Parameters :
+         *      - color : the color of the cemetery (WHITE or BLACK)
+         *      - slot  : the index of the space (0 - 15)
+         *
+         * - Return : the type of the piece, 'E' if the space is free
+         */
+        char getPiece(bool color, int slot);
+
+        /**
+         * Get the busy spaces of a cemetery
+         *
+         * - Parameters :
+         *      - color : the color of the cemetery (WHITE or BLACK)
+         *
+         * - Return : the mask of the busy spaces (bit i = space i)
+         */
+        unsigned short getOccupancy(bool color);
+
+        /**
+         * Show a string representation of the object
+         *
+         * - Return : a string representation of the object
+         */
+        void toString();
+
+    private:
+        /**
+         * Find the index used for a type of piece in the masks
+         *
+         * - Parameters :
+         *      - piece : the type of the piece ('P', 'R', 'B', 'H', 'Q', 'K')
+         *
+         * - Return : the index of the type (0 - 5)
+         */
+        static int typeIndex(char piece);
+
+        /**
+         * Find the space of a mask that is the nearest one to a cell
+         *
+         * - Parameters :
+         *      - color : the color of the cemetery (WHITE or BLACK)
+         *      - mask  : the spaces among which to choose (bit i = space i)
+         *      - x     : the column of the cell (0 is the A column)
+         *      - y     : the row of the cell (0 is the 1 row)
+         *
+         * - Return : the index of the space (0 - 15), -1 if the mask is empty
+         */
+        static int nearest(bool color, unsigned short mask, int x, int y);
+
+        /**
+         * Private variables
+         *
+         * occupancy : for any color, the bit i is set if the space i is busy
+         * types     : for any color and type of piece, the bit i is set if the space i holds a piece of that type
+         */
+        unsigned short occupancy[2];
+        unsigned short types[2][6];
+};
+
+#endif
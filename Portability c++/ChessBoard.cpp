@@ -20,14 +20,36 @@
 #include "Config.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
 
 using namespace std;
 
+// Initial position of the pieces in FEN notation (RESET command)
+#define INITIAL_POSITION "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR"
+
+// Name of a type of piece (same chars used by the Cell class), as in the commands of the player
+static const char * pieceName(char piece){
+    switch(piece){
+        case 'P': return "PEDINA";
+        case 'R': return "TORRE";
+        case 'H': return "CAVALLO";
+        case 'B': return "ALFIERE";
+        case 'K': return "RE";
+        default : return "REGINA";
+    }
+}
+
 // Constructor
 ChessBoard::ChessBoard() {
     // Turn controller inizialization (start the white player - WHITE --> 0)
     turn = false;
-    solenoid = "A1";
+    outcome = OUTCOME_COMMAND;
+    ambiguous = false;
+    // the solenoid starts from the center of the A1 cell
+    solenoidX = 0;
+    solenoidY = 0;
+    cncPowered = false;
 
     for(int i = 0; i < 8; i++){
         for(int j = 0; j < 8; j++){
@@ -38,9 +60,9 @@ ChessBoard::ChessBoard() {
                 if(i == 0 || i == 7){
                   cbState[i][j] = new Cell(true,'W', 'R');  // cell busy by white rooks
                 } else if(i == 1 || i == 6){
-                  cbState[i][j] = new Cell(true,'W', 'B');  // cell busy by white bishops
-                } else if(i == 2 || i == 5){
                   cbState[i][j] = new Cell(true,'W', 'H');  // cell busy by white knights
+                } else if(i == 2 || i == 5){
+                  cbState[i][j] = new Cell(true,'W', 'B');  // cell busy by white bishops
                 } else if(i == 3){
                   cbState[i][j] = new Cell(true,'W', 'Q');  // cell busy by white queen
                 } else if(i == 4){
@@ -54,9 +76,9 @@ ChessBoard::ChessBoard() {
                 if(i == 0 || i == 7){
                   cbState[i][j] = new Cell(true,'B', 'R');  // cell busy by black rooks
                 } else if(i == 1 || i == 6){
-                  cbState[i][j] = new Cell(true,'B', 'B');  // cell busy by black bishops
-                } else if(i == 2 || i == 5){
                   cbState[i][j] = new Cell(true,'B', 'H');  // cell busy by black knights
+                } else if(i == 2 || i == 5){
+                  cbState[i][j] = new Cell(true,'B', 'B');  // cell busy by black bishops
                 } else if(i == 3){
                   cbState[i][j] = new Cell(true,'B', 'Q');  // cell busy by black queen
                 } else if(i == 4){
@@ -71,14 +93,15 @@ ChessBoard::ChessBoard() {
 }
 
 // Move function implementation
-void ChessBoard::move(queue<char *> wordsQueue){
+void ChessBoard::move(queue<char *> & wordsQueue){
     // Auxiliary variables
     bool promotion = false;
     bool errorFlag = false;
     char * promoType;
+    char * promotionType = NULL;
     char * from;
-    char * destination;
-    char * candidate;
+    char * destination = NULL;
+    char * candidate = NULL;
 
     /*
      *  Command interpretation and move execution phase
@@ -88,12 +111,38 @@ void ChessBoard::move(queue<char *> wordsQueue){
     char * piece = wordsQueue.front();
     wordsQueue.pop();
 
+    // the hypotheses just rejected tell if this move is ambiguous
+    bool wasAmbiguous = ambiguous;
+    ambiguous = false;
+    outcome = OUTCOME_COMMAND;
+
     // Print state of the game
     if(strcmp(piece,"CHECK\n") == 0){
         toString();
         return;
     }
 
+    // Bring the pieces back to the initial position
+    if(strcmp(piece,"RESET\n") == 0){
+        if(!setUp(INITIAL_POSITION, "w", "KQkq")){
+            printf("\n\nThe reset has been stopped!\n");
+        }
+        return;
+    }
+
+    // Bring the pieces to a position in FEN notation (es: FEN rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b KQkq)
+    if(strcmp(piece,"FEN") == 0){
+        const char * fields[3] = {"", "w", "-"};
+        for(int i = 0; i < 3 && !wordsQueue.empty(); i++){
+            fields[i] = wordsQueue.front();
+            wordsQueue.pop();
+        }
+        if(!setUp(fields[0], fields[1], fields[2])){
+            printf("\n\nInvalid position! Try again!\n");
+        }
+        return;
+    }
+
     // If the piece is a pawn, verify if the move refers to a promoted pawn
     if(strcmp(piece,"PEDINA") == 0){
         if((wordsQueue.size() == 5 || wordsQueue.size() == 3) && wordsQueue.front() == "TORRE" || wordsQueue.front() == "CAVALLO" || wordsQueue.front() == "ALFIERE" || wordsQueue.front() == "REGINA"){
@@ -108,6 +157,24 @@ void ChessBoard::move(queue<char *> wordsQueue){
         wordsQueue.pop();
     }
 
+    // a pawn that reaches the last row can be followed by the type of the new piece (es: PEDINA A E8 TORRE)
+    if(strcmp(piece,"PEDINA") == 0 && (wordsQueue.size() == 2 || wordsQueue.size() == 4)){
+        queue<char *> moveWords;
+        while(wordsQueue.size() > 1){
+            moveWords.push(wordsQueue.front());
+            wordsQueue.pop();
+        }
+        promotionType = wordsQueue.front();
+        // remove last character that is the terminal character
+        promotionType[strlen(promotionType)-1]='\0';
+        wordsQueue = moveWords;
+
+        if(strcmp(promotionType,"TORRE") != 0 && strcmp(promotionType,"ALFIERE") != 0 &&
+           strcmp(promotionType,"CAVALLO") != 0 && strcmp(promotionType,"REGINA") != 0){
+            errorFlag = true;
+        }
+    }
+
     // Analyze the cases
     if (wordsQueue.size() == 3){       // ambiguous cases
         // prevents errors if the source is a non valid word
@@ -120,22 +187,22 @@ void ChessBoard::move(queue<char *> wordsQueue){
         // Superfluous word (preposition)
         wordsQueue.pop();
 
-        // prevents errors if the destination is a non valid word
-        if(strlen(wordsQueue.front()) == 3){
+        // prevents errors if the destination is a non valid word (the terminal character follows the promotion type)
+        if(strlen(wordsQueue.front()) == (promotionType == NULL ? 3 : 2)){
             destination = wordsQueue.front();
             // remove last character that is the terminal character
-            destination[strlen(destination)-1]=NULL;
+            destination[2]='\0';
             wordsQueue.pop();
         } else{
             errorFlag = true;
         }
     } else if(wordsQueue.size() == 1){ // ordinary cases
         from = NULL;
-        // prevents errors if the destination is a non valid word
-        if(strlen(wordsQueue.front()) == 3){
+        // prevents errors if the destination is a non valid word (the terminal character follows the promotion type)
+        if(strlen(wordsQueue.front()) == (promotionType == NULL ? 3 : 2)){
             destination = wordsQueue.front();
             // remove last character that is the terminal character
-            destination[strlen(destination)-1]=NULL;
+            destination[2]='\0';
         } else{
             errorFlag = true;
         }
@@ -143,43 +210,119 @@ void ChessBoard::move(queue<char *> wordsQueue){
             errorFlag = true;
     }
 
+    // the type of the new piece can be chosen only when a pawn reaches the last row
+    if(promotionType != NULL && !errorFlag && destination[1] != (turn ? '1' : '8')){
+        errorFlag = true;
+    }
+
     //printf("\n\n%d  %d %s  %s\n\n", promotion,errorFlag,from,destination);
     // verify if there is a candidate for the move
-    if(strcmp(piece,"PEDINA") == 0 && !errorFlag){//printf("\n\nentro----\n");
-        if(promotion){
-            candidate = pawnsManager.checkPromotedCandidates(cbState, turn, promoType, from);
-            if(candidate != NULL){
-                if(promoType == "TORRE"){
-                    from = candidate;
-                    candidate = rooksManager.checkCandidates(cbState,turn,from,destination);
-                } else if(promoType == "ALFIERE"){
-                    from = candidate;
-                    candidate = bishopsManager.checkCandidates(cbState,turn,from,destination);
-                } else if(promoType == "CAVALLO"){
-                    from = candidate;
-                    candidate = knightsManager.checkCandidates(cbState,turn,from,destination);
-                } else if(promoType == "REGINA"){
-                    from = candidate;
-                    candidate = queensManager.checkCandidates(cbState,turn,from,destination);
-                } else if(promoType == "RE"){
-                    from = candidate;
-                    candidate = kingsManager.checkCandidates(cbState,turn,from,destination);
-                }
+    if(!errorFlag){
+        candidate = findCandidate(piece, promotion ? promoType : NULL, from, destination);
+    }
+    perform(piece, candidate, destination, promotionType);
+    if(outcome == OUTCOME_INVALID && wasAmbiguous){
+        outcome = OUTCOME_AMBIGUOUS;
+    }
+};
+
+// Move function implementation (binary move frames)
+void ChessBoard::move(char piece, const char * from, const char * to, char promotion){
+    char source[3] = {from[0], from[1], '\0'};
+    char destination[3] = {to[0], to[1], '\0'};
+    const char * name = pieceName(piece);
+    const char * promoType = NULL;
+    const char * promotionType = NULL;
+
+    // a pawn promoted while its new type was captured stays in its cell, but it moves as its new type
+    if(piece != 'P' && cbState[from[0] - 65][from[1] - 49]->getPiece() == 'P'){
+        promoType = name;
+        name = "PEDINA";
+    }
+    // the type of the new piece is considered only when a pawn reaches the last row
+    if(piece == 'P' && to[1] == (turn ? '1' : '8')){
+        promotionType = pieceName(promotion);
+    }
+
+    // en passant: the pawn goes diagonally behind the pawn that has just performed a double step, beside it
+    const char * passant = pawnsManager.getEnPassant(turn);
+    if(piece == 'P' && passant != NULL && to[0] == passant[0] && from[1] == passant[1] && abs(to[0] - from[0]) == 1 &&
+       to[1] == from[1] + (turn ? -1 : 1) && !cbState[to[0] - 65][to[1] - 49]->getBusy() &&
+       cbState[from[0] - 65][from[1] - 49]->getPiece() == 'P' && cbState[from[0] - 65][from[1] - 49]->getColor() == (turn ? 'B' : 'W')){
+        char victim[3] = {passant[0], passant[1], '\0'};
+        ambiguous = false;
+        performEnPassant(source, destination, victim);
+        return;
+    }
+
+    perform(name, findCandidate(name, promoType, source, destination), destination, promotionType);
+};
+
+// Move function implementation (hypotheses of the speech recognizer)
+bool ChessBoard::move(char * hypotheses[], int numHypotheses){
+    Move moves[MAX_MOVES];
+    char frame[MOVE_FRAME_SIZE];
+    char piece, promotion;
+    char from[3], to[3];
+
+    parser.load(moves, legalMoves(moves), turn);
+    ambiguous = false;
+    for(int i = 0; i < numHypotheses; i++){
+        bool resolved = parser.resolve(hypotheses[i], frame);
+        if(i == 0){
+            ambiguous = parser.getMatches() > 1;
+        }
+        if(resolved && MoveFrame::decode(frame, &piece, from, to, &promotion)){
+            if(i > 0){
+                printf("\n\nHypothesis %d of %d : %s\n", i + 1, numHypotheses, hypotheses[i]);
             }
-        } else{
-            candidate = pawnsManager.checkCandidates(cbState,turn,from,destination);
+            move(piece, from, to, promotion);
+            ambiguous = false;
+            return true;
         }
-    } else if(strcmp(piece,"TORRE") == 0 && !errorFlag){
-        candidate = rooksManager.checkCandidates(cbState, turn,from,destination);
-    } else if(strcmp(piece,"ALFIERE") == 0 && !errorFlag){
-        candidate = bishopsManager.checkCandidates(cbState, turn,from,destination);
-    } else if(strcmp(piece,"CAVALLO") == 0 && !errorFlag){
-        candidate = knightsManager.checkCandidates(cbState, turn,from,destination);
-    } else if(strcmp(piece,"REGINA") == 0 && !errorFlag){
-        candidate = queensManager.checkCandidates(cbState, turn,from,destination);
-    } else if(strcmp(piece,"RE") == 0 && !errorFlag){
-        candidate = kingsManager.checkCandidates(cbState, turn, from,destination);
     }
+    return false;
+};
+
+// FindCandidate function implementation
+char * ChessBoard::findCandidate(const char * piece, const char * promoType, const char * from, const char * destination){
+    saveState();
+    if(strcmp(piece,"PEDINA") == 0 && promoType != NULL){
+        // the promoted pawn is found first, then it is verified as a piece of its new type
+        from = pawnsManager.checkPromotedCandidates(cbState, turn, promoType, from);
+        if(from == NULL){
+            return NULL;
+        }
+        piece = promoType;
+    }
+
+    if(strcmp(piece,"PEDINA") == 0){
+        return pawnsManager.checkCandidates(cbState, turn, from, destination);
+    } else if(strcmp(piece,"TORRE") == 0){
+        return rooksManager.checkCandidates(cbState, turn, from, destination);
+    } else if(strcmp(piece,"ALFIERE") == 0){
+        return bishopsManager.checkCandidates(cbState, turn, from, destination);
+    } else if(strcmp(piece,"CAVALLO") == 0){
+        return knightsManager.checkCandidates(cbState, turn, from, destination);
+    } else if(strcmp(piece,"REGINA") == 0){
+        return queensManager.checkCandidates(cbState, turn, from, destination);
+    } else if(strcmp(piece,"RE") == 0){
+        return kingsManager.checkCandidates(cbState, turn, from, destination);
+    }
+    return NULL;
+};
+
+// Perform function implementation
+void ChessBoard::perform(const char * piece, char * candidate, char * destination, const char * promotionType){
+    char promotionPiece;
+
+    // more candidates are more pieces that can reach the destination
+    if(candidate == NULL){
+        outcome = OUTCOME_INVALID;
+    } else {
+        outcome = strlen(candidate) == 2 ? OUTCOME_PERFORMED : OUTCOME_AMBIGUOUS;
+    }
+
     // if there is a candidate, perform the move
     if(candidate != NULL){
         if(strlen(candidate) == 2){
@@ -187,13 +330,70 @@ void ChessBoard::move(queue<char *> wordsQueue){
             int row = destination[0] - 65;
             // '1' corresponds to 49 - 49 = 0, '2' to 50 - 49 = 1, etc.
             int col = destination[1] - 49;
-            // verify if a piece must be transported to the cemetery
-            if(cbState[row][col]->getColor() == 'D'){
+            bool promoted = false;
+            bool performed = true;
+            // a pawn that reaches the last row is promoted (to a queen if the player has not chosen the type):
+            // if a piece of that type has been captured, the pawn is swapped with it
+            if(strcmp(piece,"PEDINA") == 0 && destination[1] == (turn ? '1' : '8')){
+                if(promotionType == NULL){
+                    promotionType = "REGINA";
+                }
+                if(strcmp(promotionType,"TORRE") == 0){
+                    promotionPiece = 'R';
+                } else if(strcmp(promotionType,"ALFIERE") == 0){
+                    promotionPiece = 'B';
+                } else if(strcmp(promotionType,"CAVALLO") == 0){
+                    promotionPiece = 'H';
+                } else {
+                    promotionPiece = 'Q';
+                }
+                int slot = cemeteryManager.findPiece(turn ? BLACK : WHITE, promotionPiece, row, col);
+                if(slot >= 0){
+                    promoted = performPromotion(candidate, destination, slot);
+                }
+                if(!promoted){
+                    // the pawn stays on the chessboard and moves as the new piece
+                    pawnsManager.promote(turn, destination, promotionType);
+                }
+            }
+
+            if(promoted){
+                if(cbState[row][col]->getColor() == 'D'){
+                    removeDead(destination, row, col);
+                }
+                // the pawn leaves the chessboard as if it were captured by the opponent
+                pawnsManager.findAndRemove(!turn, destination);
+                if(promotionPiece == 'R'){
+                    rooksManager.revive(turn, destination);
+                } else if(promotionPiece == 'B'){
+                    bishopsManager.revive(turn, destination);
+                } else if(promotionPiece == 'H'){
+                    knightsManager.revive(turn, destination);
+                } else {
+                    queensManager.revive(turn, destination);
+                }
+                piece = promotionType;
+            } else if(strcmp(piece,"RE") == 0 && abs(destination[0] - candidate[0]) == 2){
+                // castling: the rook is moved in the same sequence of the king
+                performed = performCastling(candidate, destination);
+            } else if(cbState[row][col]->getColor() == 'D'){
+                // verify if a piece must be transported to the cemetery
               // switch on alert led for 5s
-                removeDead(destination, row, col);
+                performed = performCapture(candidate, destination);
+                if(performed){
+                    removeDead(destination, row, col);
+                }
+            } else {
+                // switch on alert led for 5s
+                performed = performMove(candidate, destination);
+            }
+
+            if(!performed){
+                // the pieces have not moved: the state of the game stays the one before the move
+                restoreState();
+                outcome = OUTCOME_UNREACHABLE;
+                return;
             }
-            // switch on alert led for 5s
-            performMove(piece, candidate, destination);
 
             // Update state of the game
             updateState(piece, candidate, destination);
@@ -208,110 +408,704 @@ void ChessBoard::move(queue<char *> wordsQueue){
     
 };
 
-void ChessBoard::performMove(const char * type, const  char * from, const char * to) {
-    //printf("\nInside performMove\n");
-  /*// transport the electromagnet in the cell where is positioned the piece that has to be moved
-  direct("A1", from);
 
-  // for all the pieces different from the knight
-  if(type != 'H'){
-        // transport the piece to the destination cell through the navigate function
-    if (navigate(from, to) == true) {
-        // report the electromagnet to the default position (A1)
-        direct(to, "A1");
+// Drift function implementation
+bool ChessBoard::drift(bool (*interrupted)()){
+  Move moves[MAX_MOVES];
+  int numMoves = moveGenerator.generate(cbState, turn, moves);
+  long sumX = 0;
+  long sumY = 0;
+
+  if(numMoves == 0){
+    return true;
+  }
+
+  // a cell with more moves is more likely to be the source of the next move, so any move counts once
+  for(int i = 0; i < numMoves; i++){
+    sumX += (moves[i].from / 8) * (long) STEPS;
+    sumY += (moves[i].from % 8) * (long) STEPS;
+  }
+  long targetX = sumX / numMoves;
+  long targetY = sumY / numMoves;
+
+  bool completed = true;
+  bool moved = false;
+  // the time (us) of the queued chunks, with the power up and the power down of the CNC board
+  long estimatedTime = 0;
+
+  while(completed && (solenoidX != targetX || solenoidY != targetY)){
+    // a chunk is queued only when the previous one has been executed, so a new command waits one chunk at most
+    while(completed && !pipeline.idle()){
+      completed = interrupted == NULL || !interrupted();
+      pipeline.pause();
+    }
+    // a new command has arrived: stop where the solenoid is, the next move starts from here
+    if(!completed || (interrupted != NULL && interrupted())){
+      completed = false;
+      break;
+    }
+
+    // move both the axes of at most DRIFT_CHUNK steps toward the target
+    long deltaX = targetX - solenoidX;
+    long deltaY = targetY - solenoidY;
+    if(labs(deltaX) > DRIFT_CHUNK){
+      deltaX = deltaX > 0 ? DRIFT_CHUNK : -DRIFT_CHUNK;
+    }
+    if(labs(deltaY) > DRIFT_CHUNK){
+      deltaY = deltaY > 0 ? DRIFT_CHUNK : -DRIFT_CHUNK;
+    }
+    // the stepper motors move only if the CNC board is powered (it is still powered after a previous move)
+    if(!cncPowered){
+      powerUp();
+      estimatedTime += (RELAY_DELAY + POWER_UP_DELAY) * 1000L;
+    }
+    estimatedTime += MotionEstimator::movementTime(labs(deltaX)) + MotionEstimator::movementTime(labs(deltaY));
+    if(deltaX != 0){
+      stepperMovement(deltaX > 0, X_DIR, labs(deltaX));
+    }
+    if(deltaY != 0){
+      stepperMovement(deltaY < 0, Y_DIR, labs(deltaY));
+    }
+    moved = true;
+  }
+
+  // the drift is a sequence of its own, so its time is not added to the next move
+  if(moved){
+    if(cncPowered){
+      powerDown();
+      estimatedTime += (FINISH_DELAY + RELAY_DELAY) * 1000L;
+    }
+    Block block = {BLOCK_END, 0, false, false, estimatedTime / 1000, "Drift"};
+    pipeline.push(block);
+  }
+  return completed;
+};
+
+// Perform move function implementation
+bool ChessBoard::performMove(const  char * from, const char * to) {
+  Motion motions[MAX_MOTIONS];
+  // 'A' corresponds to 65 - 65 = 0, 'B' to 66 - 65 = 1, 'C' to 67 - 65 = 2, etc.
+  // '1' corresponds to 49 - 49 = 0, '2' to 50 - 49 = 1, etc.
+  int fromX = from[0] - 65;
+  int fromY = from[1] - 49;
+
+  // transport the electromagnet from wherever it is to the cell where is positioned the piece that has to be moved,
+  // then transport the piece to the destination cell along the route of the pathPlanner (also the knight, that
+  // moves along the edges of the cells): the electromagnet remains on the destination cell waiting for the next move
+  int numMotions = planTravel(fromX * STEPS, fromY * STEPS, motions, 0);
+  numMotions = planCarry(fromX, fromY, to[0] - 65, to[1] - 49, motions, numMotions);
+  if(numMotions < 0){
+    printf("\n\nThe piece cannot reach its destination!\n");
+    return false;
+  }
+
+  execute("Move", motions, numMotions);
+  return true;
+};
+
+// Perform capture function implementation
+bool ChessBoard::performCapture(const char * from, const char * to) {
+  Motion motions[MAX_MOTIONS];
+  int slot;
+
+  int numMotions = planCapture(from, to, to, motions, &slot);
+  if(numMotions < 0){
+    printf("\n\nThe captured piece cannot reach the cemetery!\n");
+    return false;
+  }
+
+  execute("Capture", motions, numMotions);
+  return true;
+};
+
+// Plan capture function implementation
+int ChessBoard::planCapture(const char * from, const char * to, const char * victim, Motion motions[], int * slot) {
+  // the captured piece goes to the cemetery of its color
+  int color = turn ? WHITE : BLACK;
+  int fromX = from[0] - 65;
+  int fromY = from[1] - 49;
+  int toX = to[0] - 65;
+  int toY = to[1] - 49;
+  int victimX = victim[0] - 65;
+  int victimY = victim[1] - 49;
+  int slotX;
+  int slotY;
+  long slotTime;
+
+  // choose the space that minimizes the transport of the captured piece plus the return of the
+  // electromagnet to the capturing piece
+  *slot = chooseSpace(color, cbState[victimX][victimY]->getPiece(), victimX, victimY, fromX * (long) STEPS, fromY * (long) STEPS, &slotTime);
+  if(*slot < 0){
+    return -1;
+  }
+  PathPlanner::cemeteryCell(color, *slot, &slotX, &slotY);
+  // the space is busy from now on, also for the route of the capturing piece
+  cemeteryManager.place(color, *slot, cbState[victimX][victimY]->getPiece());
+
+  int numMotions = planTravel(victimX * STEPS, victimY * STEPS, motions, 0);
+  numMotions = planCarry(victimX, victimY, slotX, slotY, motions, numMotions);
+  numMotions = planTravel(fromX * STEPS, fromY * STEPS, motions, numMotions);
+  numMotions = planCarry(fromX, fromY, toX, toY, motions, numMotions);
+  if(numMotions < 0){
+    cemeteryManager.remove(color, *slot);
+    *slot = -1;
+  }
+  return numMotions;
+};
+
+// Perform en passant function implementation
+void ChessBoard::performEnPassant(const char * from, const char * to, const char * victim) {
+  Motion motions[MAX_MOTIONS];
+  int slot;
+
+  int numMotions = planCapture(from, to, victim, motions, &slot);
+  if(numMotions < 0){
+    printf("\n\nThe captured piece cannot reach the cemetery!\n");
+    outcome = OUTCOME_UNREACHABLE;
+    return;
+  }
+  execute("EnPassant", motions, numMotions);
+
+  // the captured pawn is not in the destination cell, so it is removed here
+  removeDead(victim, victim[0] - 65, victim[1] - 49);
+  pawnsManager.enPassant(turn, from, to);
+  updateState("PEDINA", from, to);
+  outcome = OUTCOME_PERFORMED;
+
+  printf("\n\nPEDINA moved from %.2s to %.2s\n", from, to);
+};
+
+// Perform promotion function implementation
+bool ChessBoard::performPromotion(const char * from, const char * to, int slot) {
+  int color = turn ? BLACK : WHITE;
+  int fromX = from[0] - 65;
+  int fromY = from[1] - 49;
+  int toX = to[0] - 65;
+  int toY = to[1] - 49;
+  int slotX;
+  int slotY;
+  int pawnX;
+  int pawnY;
+  long time;
+  Motion motions[MAX_MOTIONS];
+  int numMotions = 0;
+  bool capture = cbState[toX][toY]->getColor() == 'D';
+  int victimSlot = -1;
+  int victimX;
+  int victimY;
+
+  PathPlanner::cemeteryCell(color, slot, &slotX, &slotY);
+
+  // the captured piece is carried to its cemetery before the pawn leaves its cell
+  if(capture){
+    victimSlot = chooseSpace(!color, cbState[toX][toY]->getPiece(), toX, toY, fromX * (long) STEPS, fromY * (long) STEPS, &time);
+    if(victimSlot < 0){
+      return false;
+    }
+    cemeteryManager.place(!color, victimSlot, cbState[toX][toY]->getPiece());
+    PathPlanner::cemeteryCell(!color, victimSlot, &victimX, &victimY);
+    numMotions = planTravel(toX * STEPS, toY * STEPS, motions, numMotions);
+    numMotions = planCarry(toX, toY, victimX, victimY, motions, numMotions);
+  }
+
+  // the pawn goes directly to its cemetery (it never reaches the last row), in the space that minimizes its carry
+  // plus the travel toward the new piece
+  int pawnSlot = chooseSpace(color, 'P', fromX, fromY, slotX * (long) STEPS, slotY * (long) STEPS, &time);
+  if(pawnSlot >= 0){
+    cemeteryManager.place(color, pawnSlot, 'P');
+    PathPlanner::cemeteryCell(color, pawnSlot, &pawnX, &pawnY);
+    numMotions = planTravel(fromX * STEPS, fromY * STEPS, motions, numMotions);
+    numMotions = planCarry(fromX, fromY, pawnX, pawnY, motions, numMotions);
+    numMotions = planTravel(slotX * STEPS, slotY * STEPS, motions, numMotions);
+    numMotions = planCarry(slotX, slotY, toX, toY, motions, numMotions);
+  }
+
+  // nothing is moved if a piece cannot reach its space
+  if(pawnSlot < 0 || numMotions < 0){
+    if(capture){
+      cemeteryManager.remove(!color, victimSlot);
+    }
+    if(pawnSlot >= 0){
+      cemeteryManager.remove(color, pawnSlot);
+    }
+    return false;
+  }
+
+  execute("Promotion", motions, numMotions);
+  cemeteryManager.remove(color, slot);
+  return true;
+};
+
+// Perform castling function implementation
+bool ChessBoard::performCastling(const char * from, const char * to) {
+  int col = from[1] - 49;
+  int kingFromX = from[0] - 65;
+  int kingToX = to[0] - 65;
+  // the rook goes from the H column to the F column or from the A column to the D column
+  int rookFromX = kingToX > kingFromX ? 7 : 0;
+  int rookToX = (kingFromX + kingToX) / 2;
+  char rookFrom[3] = {(char) (rookFromX + 65), from[1], '\0'};
+  char rookTo[3] = {(char) (rookToX + 65), from[1], '\0'};
+  Motion motions[MAX_MOTIONS];
+
+  int numMotions = planTravel(kingFromX * STEPS, col * STEPS, motions, 0);
+  numMotions = planCarry(kingFromX, col, kingToX, col, motions, numMotions);
+
+  // the route of the rook is planned with the king on its destination cell, so the rook goes around it
+  // along the edges of the cells (the cells of the king are updated with the rest of the move)
+  cbState[kingFromX][col]->setBusy();
+  cbState[kingToX][col]->setBusy();
+  numMotions = planTravel(rookFromX * STEPS, col * STEPS, motions, numMotions);
+  numMotions = planCarry(rookFromX, col, rookToX, col, motions, numMotions);
+  cbState[kingFromX][col]->setBusy();
+  cbState[kingToX][col]->setBusy();
+
+  if(numMotions < 0){
+    printf("\n\nThe rook cannot reach its destination!\n");
+    return false;
+  }
+  execute("Castling", motions, numMotions);
+
+  // the rook is moved here, the king with the rest of the move
+  rooksManager.castle(turn, rookFrom, rookTo);
+  updateCells("TORRE", rookFrom, rookTo);
+  return true;
+};
+
+// Set up function implementation
+bool ChessBoard::setUp(const char * placement, const char * side, const char * castling){
+  // FEN letters of the types, in the same order of the types of the cells
+  const char letters[] = "PRBNQK";
+  const char types[] = "PRBHQK";
+  char targetColors[8][8];
+  char targetPieces[8][8];
+  Transfer transfers[MAX_TRANSFERS];
+  int kings[2] = {0, 0};
+  // the placement starts from the A8 cell
+  int row = 0;
+  int col = 7;
+  bool completed = true;
+
+  for(int i = 0; i < 8; i++){
+    for(int j = 0; j < 8; j++){
+      targetColors[i][j] = 'E';
+      targetPieces[i][j] = 'E';
+    }
+  }
+
+  // the rows go from 8 to 1, separated by '/': a letter is a piece, a digit is a number of empty cells
+  for(const char * c = placement; *c != '\0' && *c != '\n'; c++){
+    if(*c == '/'){
+      if(row != 8 || col == 0){
+        return false;
+      }
+      row = 0;
+      col--;
+    } else if(*c >= '1' && *c <= '8'){
+      row += *c - '0';
+    } else {
+      const char * letter = strchr(letters, toupper(*c));
+      if(letter == NULL || row > 7){
+        return false;
+      }
+      // uppercase for the white pieces, lowercase for the black ones
+      targetColors[row][col] = isupper(*c) ? 'W' : 'B';
+      targetPieces[row][col] = types[letter - letters];
+      if(targetPieces[row][col] == 'K'){
+        kings[isupper(*c) ? WHITE : BLACK]++;
+      }
+      row++;
+    }
+    if(row > 8){
+      return false;
+    }
+  }
+  if(row != 8 || col != 0 || kings[WHITE] != 1 || kings[BLACK] != 1){
+    return false;
+  }
+
+  int numTransfers = setupPlanner.plan(cbState, cemeteryManager, targetColors, targetPieces, solenoidX, solenoidY, transfers);
+  if(numTransfers < 0){
+    return false;
+  }
+
+  for(int i = 0; i < numTransfers; i++){
+    int fromX = transfers[i].fromX;
+    int fromY = transfers[i].fromY;
+    int toX = transfers[i].toX;
+    int toY = transfers[i].toY;
+    bool color = transfers[i].color == 'B' ? BLACK : WHITE;
+
+    direct(fromX * (long) STEPS, fromY * (long) STEPS);
+    if(!navigate(fromX, fromY, toX, toY)){
+      completed = false;
+      break;
+    }
+
+    // the cells are updated after any transfer, so that the next routes avoid the piece
+    if(fromX >= 0 && fromX <= 7){
+      cbState[fromX][fromY]->setBusy();
+      cbState[fromX][fromY]->setColor('E');
+      cbState[fromX][fromY]->setPiece('E');
+    } else {
+      cemeteryManager.remove(color, PathPlanner::cemeterySlot(fromX, fromY));
+    }
+    if(toX >= 0 && toX <= 7){
+      cbState[toX][toY]->setBusy();
+      cbState[toX][toY]->setColor(transfers[i].color);
+      cbState[toX][toY]->setPiece(transfers[i].piece);
     } else {
-        // executed only in case of error: bring back the electromagnet to the default position (A1)
-        direct(from, "A1");
+      cemeteryManager.place(color, PathPlanner::cemeterySlot(toX, toY), transfers[i].piece);
     }
-  } else{       // in case of knight move
-        //implement all the cases
-  }*/
+  }
+  powerDown();
+
+  // the state of the game follows the pieces on the chessboard
+  loadPieces();
+  kingsManager.setCastling(cbState, castling);
+  turn = side[0] == 'b';
+
+  // the time of the setup is printed when the pieces have reached their cells
+  printf("\nSetup planned : %d transfers\n", numTransfers);
+  Block block = {BLOCK_END, 0, false, false, -1, "Setup"};
+  pipeline.push(block);
+  return completed;
 };
 
-// Navigate funtion implementation
-bool ChessBoard::navigate(const char * from, const char * to) {
-  printf("\nInside navigate\n");
-  // power up the CNC board
-  //digitalWrite (POWER_CNC, HIGH);
-  //power up the magnet
-  //digitalWrite (POWER_MAGNET, HIGH);
+// Load pieces function implementation
+void ChessBoard::loadPieces(){
+  Manager * managers[6] = {&pawnsManager, &rooksManager, &bishopsManager, &knightsManager, &queensManager, &kingsManager};
+  const char types[6] = {'P', 'R', 'B', 'H', 'Q', 'K'};
 
-  // wait the board to power up
-  //delay(1000);
+  for(int player = WHITE; player <= BLACK; player++){
+    for(int t = 0; t < 6; t++){
+      char positions[8][3];
+      int count = 0;
+      for(int i = 0; i < 8; i++){
+        for(int j = 0; j < 8; j++){
+          if(cbState[i][j]->getBusy() && cbState[i][j]->getColor() == (player == WHITE ? 'W' : 'B') &&
+             cbState[i][j]->getPiece() == types[t] && count < 8){
+            positions[count][0] = i + 65;
+            positions[count][1] = j + 49;
+            positions[count][2] = '\0';
+            count++;
+          }
+        }
+      }
+      managers[t]->setUp(player, positions, count);
+    }
+  }
+};
 
-  // es: navigate from A1 to C3
-  bool dirX = to[0] > from[0]; // es: C > A --> true
-  bool dirY = to[1] < from[1]; // es: 3 > 1 --> true
-  // es: navigate from A1 to C3
-  int deltaX = abs(to[0] - from[0]);  // es: C - A = 2
-  int deltaY = abs(to[1] - from[1]);  // es: 3 - 1 = 2
+// Choose space function implementation
+int ChessBoard::chooseSpace(bool color, char piece, int fromX, int fromY, long nextX, long nextY, long * time){
+  Waypoint path[MAX_WAYPOINTS];
+  unsigned short candidates = cemeteryManager.getCandidates(color, piece);
+  int slot = -1;
 
-  if (deltaX == deltaY) {
-    // diagonal
-    for (int i = 0; i < deltaX * STEPS/5; i++) {
-      stepperMovement(dirX, X_DIR, X_STP, 5);
-      stepperMovement(dirY, Y_DIR, Y_STP, 5);
+  pathPlanner.setObstacles(cbState, cemeteryManager.getOccupancy(WHITE), cemeteryManager.getOccupancy(BLACK));
+  for(int i = 0; i < CEMETERY_SLOTS; i++){
+    int x;
+    int y;
+    if(!((candidates >> i) & 1)){
+      continue;
+    }
+    PathPlanner::cemeteryCell(color, i, &x, &y);
+    int numWaypoints = pathPlanner.plan(fromX, fromY, x, y, path);
+    if(numWaypoints == 0){
+      continue;
+    }
+    long spaceTime = PathPlanner::routeTime(path, numWaypoints) + MotionEstimator::directTime(x * (long) STEPS, y * (long) STEPS, nextX, nextY);
+    if(slot < 0 || spaceTime < *time){
+      slot = i;
+      *time = spaceTime;
+    }
+  }
+  return slot;
+};
+
+// Legal moves function implementation
+int ChessBoard::legalMoves(Move moves[]){
+  int numMoves = moveGenerator.generate(cbState, turn, moves);
+
+  // the en passant depends on the previous move, known only by the pawnsManager: a pawn beside the pawn that
+  // has just performed a double step captures it going behind it
+  const char * passant = pawnsManager.getEnPassant(turn);
+  if(passant != NULL){
+    int row = passant[0] - 65;
+    int col = passant[1] - 49;
+    int behind = col + (turn ? -1 : 1);
+    for(int side = -1; side <= 1; side += 2){
+      if(row + side < 0 || row + side > 7 || behind < 0 || behind > 7 || numMoves == MAX_MOVES){
+        continue;
+      }
+      Cell * source = cbState[row + side][col];
+      if(source->getPiece() == 'P' && source->getColor() == (turn ? 'B' : 'W') && !cbState[row][behind]->getBusy()){
+        moves[numMoves].from = (row + side) * 8 + col;
+        moves[numMoves].to = row * 8 + behind;
+        moves[numMoves].piece = 'P';
+        moves[numMoves].capture = true;
+        numMoves++;
+      }
+    }
+  }
+  return numMoves;
+};
+
+// Get outcome function implementation
+int ChessBoard::getOutcome(){
+  return outcome;
+};
+
+// Estimate move function implementation
+long ChessBoard::estimateMove(const char * from, const char * to){
+  Motion motions[MAX_MOTIONS];
+  int numMotions;
+  int toX = to[0] - 65;
+  int toY = to[1] - 49;
+
+  if(cbState[toX][toY]->getBusy()){
+    int slot;
+    numMotions = planCapture(from, to, to, motions, &slot);
+    // the estimate leaves the cemetery as it is
+    if(slot >= 0){
+      cemeteryManager.remove(turn ? WHITE : BLACK, slot);
     }
   } else {
-    if (deltaX * deltaX == 0) {     // horizontal or vertical move
-      stepperMovement(dirX, X_DIR, X_STP, STEPS * deltaX);
-      stepperMovement(dirY, Y_DIR, Y_STP, STEPS * deltaY);
-    } else {      // move not valid
-      // switch off the electromagnet
-      //digitalWrite (POWER_MAGNET, LOW);
-      return false;
+    numMotions = planTravel((from[0] - 65) * STEPS, (from[1] - 49) * STEPS, motions, 0);
+    numMotions = planCarry(from[0] - 65, from[1] - 49, toX, toY, motions, numMotions);
+  }
+  if(numMotions < 0){
+    return -1;
+  }
+  return MotionEstimator::estimate(solenoidX, solenoidY, cncPowered, motions, numMotions);
+};
+
+// Plan travel function implementation
+int ChessBoard::planTravel(int x, int y, Motion motions[], int numMotions){
+  if(numMotions < 0 || numMotions == MAX_MOTIONS){
+    return -1;
+  }
+  motions[numMotions].x = x;
+  motions[numMotions].y = y;
+  motions[numMotions].carry = false;
+  return numMotions + 1;
+};
+
+// Plan carry function implementation
+int ChessBoard::planCarry(int fromX, int fromY, int toX, int toY, Motion motions[], int numMotions){
+  Waypoint path[MAX_WAYPOINTS];
+
+  if(numMotions < 0){
+    return -1;
+  }
+
+  // find the route avoiding the pieces on the chessboard and in the cemeteries
+  pathPlanner.setObstacles(cbState, cemeteryManager.getOccupancy(WHITE), cemeteryManager.getOccupancy(BLACK));
+  int numWaypoints = pathPlanner.plan(fromX, fromY, toX, toY, path);
+  if(numWaypoints == 0 || numMotions + numWaypoints - 1 > MAX_MOTIONS){
+    return -1;
+  }
+
+  // the first waypoint is the source cell, where the solenoid already is
+  for(int i = 1; i < numWaypoints; i++){
+    motions[numMotions].x = path[i].x;
+    motions[numMotions].y = path[i].y;
+    motions[numMotions].carry = true;
+    numMotions++;
+  }
+  return numMotions;
+};
+
+// Execute function implementation
+void ChessBoard::execute(const char * name, Motion motions[], int numMotions){
+  long estimatedTime = MotionEstimator::estimate(solenoidX, solenoidY, cncPowered, motions, numMotions);
+  bool magnet = false;
+
+  for(int i = 0; i < numMotions; i++){
+    // power up (or down) the electromagnet at the start (or at the end) of a carry
+    if(motions[i].carry != magnet){
+      if(motions[i].carry){
+        powerUp();
+      }
+      switchRelay(POWER_MAGNET, motions[i].carry);
+      magnet = motions[i].carry;
+    }
+    if(motions[i].carry){
+      travel(motions[i].x, motions[i].y);
+    } else {
+      direct(motions[i].x, motions[i].y);
     }
   }
+  if(magnet){
+    switchRelay(POWER_MAGNET, false);
+  }
+  powerDown();
 
-  // wait the CNC to finish
-  //delay(500);
+  // the times are printed by the pipeline when the sequence has been executed
+  Block block = {BLOCK_END, 0, false, false, estimatedTime, name};
+  pipeline.push(block);
+};
+
+// Wait motion function implementation
+void ChessBoard::waitMotion(){
+  while(!pipeline.idle()){
+    pipeline.pause();
+  }
+};
+
+// Get motion duration function implementation
+unsigned long ChessBoard::getMotionDuration(){
+  return pipeline.getLastDuration();
+};
+
+// Trace motion function implementation
+bool ChessBoard::traceMotion(const char * path){
+  return pipeline.openTrace(path);
+};
+
+// Stream motion function implementation
+bool ChessBoard::streamMotion(const char * device){
+  // the controller starts from the position that the solenoid will have after the queued motions
+  waitMotion();
+  return pipeline.openController(device, solenoidX, solenoidY);
+};
+
+// Navigate funtion implementation
+bool ChessBoard::navigate(int fromX, int fromY, int toX, int toY) {
+  printf("\nInside navigate\n");
+  Waypoint path[MAX_WAYPOINTS];
+
+  // find the route avoiding the pieces on the chessboard and in the cemeteries
+  pathPlanner.setObstacles(cbState, cemeteryManager.getOccupancy(WHITE), cemeteryManager.getOccupancy(BLACK));
+  int numWaypoints = pathPlanner.plan(fromX, fromY, toX, toY, path);
+
+  // move not valid
+  if(numWaypoints == 0){
+    return false;
+  }
+
+  powerUp();
+  //power up the magnet
+  switchRelay(POWER_MAGNET, true);
+
+  // the first waypoint is the source cell, where the solenoid already is
+  for(int i = 1; i < numWaypoints; i++){
+    travel(path[i].x, path[i].y);
+  }
 
   //power off the electromagnet
-  //digitalWrite (POWER_MAGNET, LOW);
-  //power off the CNC board
-  //digitalWrite (POWER_CNC, LOW);
+  switchRelay(POWER_MAGNET, false);
 
   return true;
 };
 
+// Travel function implementation
+void ChessBoard::travel(long x, long y){
+  bool dirX = x > solenoidX;
+  bool dirY = y < solenoidY;
+  long deltaX = labs(x - solenoidX);
+  long deltaY = labs(y - solenoidY);
+
+  if(deltaX == deltaY){
+    // diagonal
+    diagonalMovement(dirX, dirY, deltaX);
+  } else {
+    // horizontal or vertical move (only one will be executed)
+    stepperMovement(dirX, X_DIR, deltaX);
+    stepperMovement(dirY, Y_DIR, deltaY);
+  }
+};
+
 // Direct function implementation
-void ChessBoard::direct(const char * from, const char * to) {
+void ChessBoard::direct(long x, long y) {
   printf("\nInside direct\n");
-  // power up the CNC board
-  //digitalWrite (POWER_CNC, HIGH);
 
-  // wait the board to power up
-  //delay(1000);
+  // the electromagnet is already in position
+  if(x == solenoidX && y == solenoidY){
+    return;
+  }
 
-  // es: navigate from A1 to C3
-  bool dirX = to[0] > from[0]; // es: C > A --> true
-  bool dirY = to[1] < from[1]; // es: 3 > 1 --> true
-  // es: navigate from A1 to C3
-  int deltaX = abs(to[0] - from[0]);  // es: C - A = 2
-  int deltaY = abs(to[1] - from[1]);  // es: 3 - 1 = 2
+  powerUp();
+
+  // es: from the solenoid position (A1) to C4
+  bool dirX = x > solenoidX;  // es: C > A --> true
+  bool dirY = y < solenoidY;  // es: 4 > 1 --> false
+  long deltaX = labs(x - solenoidX);  // es: (C - A) * STEPS = 2 * STEPS
+  long deltaY = labs(y - solenoidY);  // es: (4 - 1) * STEPS = 3 * STEPS
+  // es: 2 * STEPS along the diagonal (A1 --> C3) and then 1 * STEPS along the Y axis (C3 --> C4)
+  long diagonal = deltaX < deltaY ? deltaX : deltaY;
+
+  diagonalMovement(dirX, dirY, diagonal);
+  stepperMovement(dirX, X_DIR, deltaX - diagonal);
+  stepperMovement(dirY, Y_DIR, deltaY - diagonal);
+};
+
+// Switch relay function implementation
+void ChessBoard::switchRelay(int pin, bool on){
+  Block block = {BLOCK_RELAY, (unsigned char) pin, on, false, 0, NULL};
+
+  pipeline.push(block);
+};
+
+// Power up function implementation
+void ChessBoard::powerUp(){
+  if(cncPowered){
+    return;
+  }
+  // power up the CNC board
+  switchRelay(POWER_CNC, true);
 
-  stepperMovement(dirX, X_DIR, X_STP, STEPS * deltaY);
-  stepperMovement(dirY, Y_DIR, Y_STP, STEPS * deltaY);
+  // wait the board to power up
+  Block block = {BLOCK_WAIT, 0, false, false, POWER_UP_DELAY, NULL};
+  pipeline.push(block);
+  cncPowered = true;
+};
 
+// Power down function implementation
+void ChessBoard::powerDown(){
+  if(!cncPowered){
+    return;
+  }
   // wait the CNC to finish
-  //delay(500);
+  Block block = {BLOCK_WAIT, 0, false, false, FINISH_DELAY, NULL};
+  pipeline.push(block);
 
   //power off the CNC board
-  //digitalWrite (POWER_CNC, LOW);
+  switchRelay(POWER_CNC, false);
+  cncPowered = false;
 };
 
 // Stepper movement function implementation
-void ChessBoard::stepperMovement (bool dir, int dirPin, int stepperPin, int steps){
+void ChessBoard::stepperMovement (bool dir, int dirPin, int steps){
     printf("\nInside stepperMovement\n");
-    //digitalWrite (dirPin, dir);
-    //delay (50);
+    if(steps == 0){
+        return;
+    }
+    // keep track of the position of the solenoid (the planned one, the pieces reach it later)
+    if(dirPin == X_DIR){
+        // dir = true moves the solenoid toward the H column
+        solenoidX += dir ? steps : -steps;
+    } else {
+        // dir = true moves the solenoid toward the 1 row
+        solenoidY += dir ? -steps : steps;
+    }
+
+    Block block = {BLOCK_MOVE, (unsigned char) (dirPin == X_DIR ? MOVE_X : MOVE_Y), dir, dir, (long) steps, NULL};
+    pipeline.push(block);
+};
 
-    /*for (int i = 0; i < steps; i++) {
-        digitalWrite (stepperPin, HIGH);
-        delayMicroseconds (800);
-        digitalWrite (stepperPin, LOW);
-        delayMicroseconds (800);
-    }*/
+// Diagonal movement function implementation
+void ChessBoard::diagonalMovement(bool dirX, bool dirY, int steps){
+    if(steps == 0){
+        return;
+    }
+    // keep track of the position of the solenoid (the planned one, the pieces reach it later)
+    solenoidX += dirX ? steps : -steps;
+    solenoidY += dirY ? -steps : steps;
+
+    Block block = {BLOCK_MOVE, (unsigned char) (MOVE_X | MOVE_Y), dirX, dirY, (long) steps, NULL};
+    pipeline.push(block);
 };
 
 // Remove dead implementation
@@ -336,7 +1130,7 @@ void ChessBoard::removeDead(const char * destination, int row, int col){
     cbState[row][col]->setColor('E');
     cbState[row][col]->setPiece('E');
 
-    // implementation of the algorithm to remove the piece
+    // the piece is transported to the cemetery by performCapture, together with the capturing piece
 
     // led signal to indicate the removal of the piece
 
@@ -345,6 +1139,52 @@ void ChessBoard::removeDead(const char * destination, int row, int col){
 // Update State function implementation
 void ChessBoard::updateState(const char * type, const char * oldPosition, const char * newPosition) {
   // update position of the piece on the ChessBoard
+  updateCells(type, oldPosition, newPosition);
+
+  // a move of a king or of a rook (or the capture of a rook) from its initial cell forbids the castling
+  kingsManager.updateCastling(oldPosition, newPosition);
+
+  // the en passant is allowed only in the move that follows the double step
+  pawnsManager.clearEnPassant(turn);
+
+  // change the turn of the player
+  setTurnPlayer();
+
+  printf("\nInside updateState\n");
+};
+
+// Save state function implementation
+void ChessBoard::saveState(){
+  savedBishops = bishopsManager;
+  savedKings = kingsManager;
+  savedKnights = knightsManager;
+  savedQueens = queensManager;
+  savedRooks = rooksManager;
+  savedPawns = pawnsManager;
+  for(int i = 0; i < 8; i++){
+    for(int j = 0; j < 8; j++){
+      savedCells[i][j] = *cbState[i][j];
+    }
+  }
+};
+
+// Restore state function implementation
+void ChessBoard::restoreState(){
+  bishopsManager = savedBishops;
+  kingsManager = savedKings;
+  knightsManager = savedKnights;
+  queensManager = savedQueens;
+  rooksManager = savedRooks;
+  pawnsManager = savedPawns;
+  for(int i = 0; i < 8; i++){
+    for(int j = 0; j < 8; j++){
+      *cbState[i][j] = savedCells[i][j];
+    }
+  }
+};
+
+// Update Cells function implementation
+void ChessBoard::updateCells(const char * type, const char * oldPosition, const char * newPosition) {
   // 'A' corresponds to 65 - 65 = 0, 'B' to 66 - 65 = 1, 'C' to 67 - 65 = 2, etc.
   int rowOld = oldPosition[0] - 65;
   // '1' corresponds to 49 - 49 = 0, '2' to 50 - 49 = 1, etc.
@@ -384,11 +1224,6 @@ void ChessBoard::updateState(const char * type, const char * oldPosition, const
   } else if(strcmp(type,"RE") == 0){
       cbState[rowNew][colNew]->setPiece('K');
   }
-
-  // change the turn of the player
-  setTurnPlayer();
-
-  printf("\nInside updateState\n");
 };
 
 // SetTurnPlayer function implementation
@@ -415,4 +1250,5 @@ void ChessBoard::toString(){
     knightsManager.toString();
     queensManager.toString();
     kingsManager.toString();
+    cemeteryManager.toString();
 };
@@ -22,11 +22,26 @@
 //#include <Arduino.h>
 //#include <QueueArray.h>
 #include "Cell.h"
+#include "CemeteryManager.h"
+#include "CommandParser.h"
 #include "Managers.h"
+#include "MotionEstimator.h"
+#include "MotionPipeline.h"
+#include "MoveGenerator.h"
+#include "PathPlanner.h"
+#include "SetupPlanner.h"
 #include <queue>
 
 using namespace std;
 
+// Outcomes of a command (getOutcome)
+#define OUTCOME_PERFORMED 0
+#define OUTCOME_INVALID 1
+#define OUTCOME_AMBIGUOUS 2
+#define OUTCOME_COMMAND 3
+#define OUTCOME_UNREACHABLE 4
+#define OUTCOMES 5
+
 class ChessBoard {
     public:
       /**
@@ -40,9 +55,117 @@ class ChessBoard {
        * Verifies if it is possible to make the move expressed by the player and, in that case, executes it
        *
        * - Parameters :
-       *      - wordsQueue : a queue containing the words relative to the move that the player want to perform
+       *      - wordsQueue : a queue containing the words relative to the move that the player want to perform (the
+       *                     words are taken from the queue, that is not copied)
+       */
+      void move(queue<char *> & wordsQueue);
+
+      /**
+       * Verifies if it is possible to make a move received as a binary frame (see MoveFrame) and, in that case,
+       * executes it as the same move expressed with words
+       *
+       * - Parameters :
+       *      - piece     : the type of the moved piece (same chars used by the Cell class)
+       *      - from      : the source cell (es: "E2")
+       *      - to        : the destination cell (es: "E4")
+       *      - promotion : the type of the new piece if a pawn reaches the last row
+       */
+      void move(char piece, const char * from, const char * to, char promotion);
+
+      /**
+       * Execute the most likely of the hypotheses of the speech recognizer that is a move: all of them are
+       * validated against the moves of the current position, generated once
+       *
+       * - Parameters :
+       *      - hypotheses    : the commands recognized, the most likely first
+       *      - numHypotheses : the number of hypotheses
+       *
+       * - Return : false if no hypothesis is a move that only a piece can perform (nothing is executed, the
+       *            first hypothesis can be left to the parser of the words, that reports the error)
+       */
+      bool move(char * hypotheses[], int numHypotheses);
+
+      /**
+       * Drift the electromagnet switched off toward the centroid of the cells from which the player that has
+       * the turn can move a piece (weighted by the number of moves of each cell), so that the first travel of
+       * the next move is shorter. The drift is performed in chunks of DRIFT_CHUNK steps and it is cancelled
+       * as soon as a new command arrives. The CNC board is powered up before the first chunk and powered down at
+       * the end of the drift, as in the other sequences
+       *
+       * - Parameters :
+       *      - interrupted : a function polled between two chunks, it returns true when a new command arrives
+       *
+       * - Return : a boolean value indicating if the drift has been completed (false if it has been cancelled)
+       */
+      bool drift(bool (*interrupted)());
+
+      /**
+       * Wait for the pieces to complete the queued sequences: the state of the game is updated when a move is
+       * queued, so the next command can be read and validated while the pieces are still moving
+       */
+      void waitMotion();
+
+      /**
+       * Get the time spent by the pieces to perform the last sequence (measured by the motion pipeline)
+       *
+       * - Return : the time (ms) of the last sequence completed
+       */
+      unsigned long getMotionDuration();
+
+      /**
+       * Record the motions executed from now on in a binary trace file, that can be replayed by TraceReplay
+       *
+       * - Parameters :
+       *      - path : the path of the trace file, it is overwritten
+       *
+       * - Return : false if the file cannot be created
+       */
+      bool traceMotion(const char * path);
+
+      /**
+       * Stream the motions to an external GRBL controller as G-code, instead of driving the stepper motors
+       *
+       * - Parameters :
+       *      - device : the path of the serial device of the controller (es: a pty of FakeGrbl)
+       *
+       * - Return : false if the device cannot be opened
+       */
+      bool streamMotion(const char * device);
+
+      /**
+       * Estimate how long a move (or a capture, if the destination cell is busy) of the current player would
+       * take, without performing it: the sequence is planned from the current position of the solenoid
+       * and its duration is computed by the MotionEstimator
+       * N.B.: the move is not validated
+       *
+       * - Parameters :
+       *      - from : the coordinates of the source cell (es: "E2")
+       *      - to   : the coordinates of the destination cell (es: "E4")
+       *
+       * - Return : the estimated duration of the move (ms), -1 if a piece cannot reach its destination
+       */
+      long estimateMove(const char * from, const char * to);
+
+      /**
+       * Generate the moves that the player that has the turn can perform in the current position (the state is
+       * updated when a move is queued, so they are valid even while the pieces are still moving)
+       *
+       * - Parameters :
+       *      - moves : the list (at least MAX_MOVES long) filled with the moves found
+       *
+       * - Return : the number of moves found
+       */
+      int legalMoves(Move moves[]);
+
+      /**
+       * Get the outcome of the last command
+       *
+       * - Return : OUTCOME_PERFORMED if a move has been performed, OUTCOME_INVALID if the move is not valid,
+       *            OUTCOME_AMBIGUOUS if more pieces can perform it, OUTCOME_COMMAND for the other commands
+       *            (CHECK, RESET, FEN), OUTCOME_UNREACHABLE if the move is valid but a piece cannot reach its
+       *            destination (the state of the game is not changed)
        */
-      void move(queue<char *> wordsQueue);
+      int getOutcome();
 
       /**
        * Show a string representation of the object
@@ -70,15 +193,9 @@ class ChessBoard {
        *                                    white ------->
        *                                        <------- black
        *
-       * cemetery : keep track of the state of the white and black cemetery spaces where the eliminated
-       *            pawns are positioned (true = free space, false = busy space)
        * turn     : keep track if moves the white (false) or the black (true)
        */
       Cell * cbState[8][8];
-      bool cemetery[2][16]    = {{true,true,true,true,true,true,true,true,
-                                  true,true,true,true,true,true,true,true},
-                                 {true,true,true,true,true,true,true,true,
-                                  true,true,true,true,true,true,true,true}};
       bool turn;
 
     private:
@@ -94,47 +211,293 @@ class ChessBoard {
        *      - dirPin     : define the stepper motor on which to act (X_DIR act on the stepper motor predisposed to move
        *                     the solenoid on the X axis while Y_DIR act on the stepper motor predisposed to move the solenoid
        *                     on the Y axis)
-       *      - stepperPin : define the stepper pin of the stepper motor on which perform the step movements (X_STP indicates
-       *                     the stepper pin of the stepper motor predisposed to move the solenoid on the X axis, while Y_STP
-       *                     indicates the stepper pin of the stepper motor predisposed to move the solenoid on the Y axis)
        *      -steps       : define the number of the steps necessary to move from xa --> xb (if the movement is performed along
        *                     the X axis) or from ya --> yb (if the movement is performed along the Y axis)
+       *
+       * N.B.: the function keeps solenoidX and solenoidY updated with the steps performed, nothing is done if
+       *       steps is 0
        */
-      void stepperMovement (bool dir, int dirPin, int stepperPin, int steps);
+      void stepperMovement (bool dir, int dirPin, int steps);
 
       /**
-       * Transport a piece from a source cell to a destination cell with the electromagnet switched on
+       * Generate the stepper motors movement in order to move the solenoid along a diagonal: the two stepper motors
+       * perform a step at the same time, so a diagonal takes the same time of a movement along a single axis
        *
        * - Parameters :
-       *      - from : represents the coordinates of the source cell
-       *      - to   : represents the coordinates of the destination cell
+       *      - dirX  : defines the direction of rotation of the stepper motor of the X axis (true = toward the H column)
+       *      - dirY  : defines the direction of rotation of the stepper motor of the Y axis (true = toward the 1 row)
+       *      - steps : define the number of the steps performed by each stepper motor
        *
-       * - Return : a boolean value indicating if the move has been succesfully performed
+       * N.B.: the function keeps solenoidX and solenoidY updated with the steps performed, nothing is done if
+       *       steps is 0
        */
-      bool navigate(const char * from, const char * to);
+      void diagonalMovement(bool dirX, bool dirY, int steps);
 
       /**
-       * Transport the electromagnet switched off from a source cell to a destination cell
+       * Move the solenoid in straight line from its current position to a point: along a single axis, along a
+       * diagonal or (for any other point) along the X axis and then along the Y axis
        *
        * - Parameters :
-       *      - from : represents the coordinates of the source cell
-       *      - to   : represents the coordinates of the destination cell
+       *      - x : the position of the point along the X axis, expressed in steps from the center of the A1 cell
+       *      - y : the position of the point along the Y axis, expressed in steps from the center of the A1 cell
+       */
+      void travel(long x, long y);
+
+      /**
+       * Transport a piece from a source cell to a destination cell with the electromagnet switched on, following
+       * the fastest route computed by the pathPlanner that does not touch the other pieces (the route passes
+       * through the centers and the edges of the cells, so it is valid also for the knight moves)
+       * N.B.: the columns of the cells go from -CEMETERY_COLUMNS to 7 + CEMETERY_COLUMNS, so that a piece can
+       *       be transported to a cemetery space
+       *
+       * - Parameters :
+       *      - fromX : the column of the source cell (0 is the A column)
+       *      - fromY : the row of the source cell (0 is the 1 row)
+       *      - toX   : the column of the destination cell
+       *      - toY   : the row of the destination cell
+       *
+       * - Return : a boolean value indicating if the move has been succesfully performed (false if there is not
+       *            a route that avoids the other pieces)
+       */
+      bool navigate(int fromX, int fromY, int toX, int toY);
+
+      /**
+       * Transport the electromagnet switched off from its current position to a point, along the diagonal
+       * and then along a single axis (the pieces on the way are not touched with the electromagnet switched off)
+       *
+       * - Parameters :
+       *      - x : the position of the point along the X axis, expressed in steps from the center of the A1 cell
+       *      - y : the position of the point along the Y axis, expressed in steps from the center of the A1 cell
+       */
+      void direct(long x, long y);
+
+      /**
+       * Switch a relay on or off, waiting RELAY_DELAY for the contacts to settle
+       *
+       * - Parameters :
+       *      - pin : the pin of the relay (POWER_MAGNET or POWER_CNC)
+       *      - on  : true to switch the relay on, false to switch it off
+       */
+      void switchRelay(int pin, bool on);
+
+      /**
+       * Power up the CNC board, if it is not already powered, and wait it to be ready
+       */
+      void powerUp();
+
+      /**
+       * Wait the CNC board to finish and power it off, if it is powered
+       */
+      void powerDown();
+
+      /**
+       * Find the piece of the player that has the turn that can perform a move, verifying it with the manager
+       * of its type
+       *
+       * - Parameters :
+       *      - piece       : the type of the moved piece, as in the commands of the player (es: "PEDINA")
+       *      - promoType   : the type of a promoted pawn that moves as a piece of that type, NULL otherwise
+       *      - from        : the source cell, NULL if it has not been expressed
+       *      - destination : the destination cell
+       *
+       * - Return : the source cell of the piece that performs the move, NULL if the move is not valid
        */
-      void direct(const char * from, const char * to);
+      char * findCandidate(const char * piece, const char * promoType, const char * from, const char * destination);
 
       /**
-       * Execute the move in three phases :
-       *  1. Transport the electromagnet switched off from A1 (default position of the magnet) to the cell
-       *     in which is positioned the pieced that has to be moved
+       * Perform a validated move (a capture, a castling or a promotion according to the cells involved) and
+       * update the state of the game, or report that the move is not valid
+       *
+       * - Parameters :
+       *      - piece         : the type of the moved piece, as in the commands of the player
+       *      - candidate     : the source cell found by findCandidate, NULL if the move is not valid
+       *      - destination   : the destination cell
+       *      - promotionType : the type of the new piece chosen by the player if a pawn reaches the last row
+       */
+      void perform(const char * piece, char * candidate, char * destination, const char * promotionType);
+
+      /**
+       * Execute the move in two phases :
+       *  1. Transport the electromagnet switched off from its current position (wherever the previous
+       *     move left it) to the cell in which is positioned the pieced that has to be moved
        *  2. Trasport the piece to the destination with the electromagnet switched on
-       *  3. Trasport the electromagnet switched off to the default position (A1)
+       *
+       * N.B.: the electromagnet is not brought back to A1 at the end of the move, the next move
+       *       starts from the destination cell of this one. The CNC board is powered once for both
+       *       the phases
        *
        * Parameters :
-       *      - type : represents the type of piece that must be moved
        *      - from : represents the coordinates of the source cell
        *      - to   : represents the coordinates of the destination cell
+       *
+       * - Return : a boolean value indicating if the move has been performed (false if the piece cannot reach
+       *            its destination, nothing is moved in that case)
+       */
+      bool performMove(const char * from, const char * to);
+
+      /**
+       * Execute a capture as a single sequence, with the CNC board powered once :
+       *  1. Transport the electromagnet switched off to the cell of the captured piece
+       *  2. Transport the captured piece to the space of its cemetery, among the ones proposed by the
+       *     cemeteryManager, that minimizes the whole sequence
+       *  3. Transport the electromagnet switched off directly to the cell of the capturing piece
+       *  4. Transport the capturing piece to the destination with the electromagnet switched on
+       * The time of the sequence estimated before the execution and the time measured by the pipeline are
+       * printed at the end
+       *
+       * Parameters :
+       *      - from : represents the coordinates of the source cell of the capturing piece
+       *      - to   : represents the coordinates of the cell of the captured piece
+       *
+       * - Return : a boolean value indicating if the capture has been performed (false if a piece cannot reach
+       *            its destination, nothing is moved in that case)
+       */
+      bool performCapture(const char * from, const char * to);
+
+      /**
+       * Execute the promotion of a pawn as a single sequence, swapping it with a captured piece of its color :
+       *  1. In case of capture, transport the captured piece to its cemetery (as performCapture)
+       *  2. Transport the pawn from its source cell directly to its cemetery, in the space that minimizes
+       *     the carry plus the travel toward the new piece
+       *  3. Transport the new piece from the cemetery to the destination cell
+       * The time of the sequence estimated before the execution and the time measured by the pipeline are
+       * printed at the end
+       *
+       * Parameters :
+       *      - from : represents the coordinates of the source cell of the pawn
+       *      - to   : represents the coordinates of the destination cell of the pawn (in the last row)
+       *      - slot : the space of the cemetery of the player holding the new piece
+       *
+       * - Return : a boolean value indicating if the promotion has been performed (false if a piece cannot
+       *            reach the cemetery, nothing is moved in that case)
+       */
+      bool performPromotion(const char * from, const char * to, int slot);
+
+      /**
+       * Execute a castling as a single sequence, with the CNC board powered once :
+       *  1. Transport the king to its destination cell (two cells along the row)
+       *  2. Transport the rook to the cell crossed by the king, going around the king along the edges
+       *     of the cells
+       * The rook is updated in the state of the game, the king is updated as any other move. The time of the
+       * sequence estimated before the execution and the time measured by the pipeline are printed at the end
+       *
+       * Parameters :
+       *      - from : represents the coordinates of the source cell of the king
+       *      - to   : represents the coordinates of the destination cell of the king
+       *
+       * - Return : a boolean value indicating if the castling has been performed (false if the rook cannot
+       *            reach its destination, nothing is moved in that case)
+       */
+      bool performCastling(const char * from, const char * to);
+
+      /**
+       * Execute an en passant as a single sequence, in the same way of performCapture, and update the state of
+       * the game: the captured pawn is beside the source cell, the capturing pawn goes behind it
+       *
+       * Parameters :
+       *      - from   : represents the coordinates of the source cell of the capturing pawn
+       *      - to     : represents the coordinates of the destination cell of the capturing pawn
+       *      - victim : represents the coordinates of the cell of the captured pawn
+       */
+      void performEnPassant(const char * from, const char * to, const char * victim);
+
+      /**
+       * Bring the pieces to a new position (RESET and FEN commands), moving them between the chessboard and
+       * the cemeteries along the transfers planned by the SetupPlanner, with the CNC board powered once.
+       * The state of the game follows the cells even if a piece cannot reach its cell (the sequence stops there)
+       * N.B.: the en passant field and the move counters of the FEN string are not used
+       *
+       * Parameters :
+       *      - placement : the piece placement field of a FEN string (es: "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR")
+       *      - side      : the active color field of a FEN string ("w" or "b")
+       *      - castling  : the castling field of a FEN string (es: "KQkq" or "-")
+       *
+       * - Return : false if the position is not valid (es: more pieces of a type than the existing ones)
+       *            or the sequence has been stopped
+       */
+      bool setUp(const char * placement, const char * side, const char * castling);
+
+      /**
+       * Place the pieces of the managers on the cells of the chessboard (the ones not on the chessboard are dead)
+       */
+      void loadPieces();
+
+      /**
+       * Choose the space of a cemetery, among the ones proposed by the cemeteryManager, where a piece is
+       * carried: the one that minimizes the carry plus the travel of the electromagnet toward the next point
+       * of the sequence. The chosen space is not set busy
+       *
+       * Parameters :
+       *      - color : the color of the piece (WHITE or BLACK)
+       *      - piece : the type of the piece
+       *      - fromX : the column of the cell of the piece
+       *      - fromY : the row of the cell of the piece
+       *      - nextX : the position along the X axis where the electromagnet goes after the carry, in steps
+       *      - nextY : the position along the Y axis where the electromagnet goes after the carry, in steps
+       *      - time  : filled with the estimated time of the carry plus the travel (ms)
+       *
+       * - Return : the index of the space (0 - 15), -1 if no space can be reached
+       */
+      int chooseSpace(bool color, char piece, int fromX, int fromY, long nextX, long nextY, long * time);
+
+      /**
+       * Plan the capture sequence of performCapture (and of performEnPassant). The space of the cemetery chosen
+       * for the captured piece is set busy (so that the route of the capturing piece avoids it) unless the
+       * planning fails
+       *
+       * - Parameters :
+       *      - from    : represents the coordinates of the source cell of the capturing piece
+       *      - to      : represents the coordinates of the destination cell of the capturing piece
+       *      - victim  : represents the coordinates of the cell of the captured piece (the destination cell, but
+       *                  for the en passant)
+       *      - motions : the list (at least MAX_MOTIONS long) filled with the motions of the sequence
+       *      - slot    : filled with the space of the cemetery chosen for the captured piece (-1 on failure)
+       *
+       * - Return : the number of motions of the sequence, -1 if a piece cannot reach its destination
+       */
+      int planCapture(const char * from, const char * to, const char * victim, Motion motions[], int * slot);
+
+      /**
+       * Append to a sequence the travel of the electromagnet switched off to a point (as the direct function)
+       *
+       * - Parameters :
+       *      - x          : the position of the point along the X axis, expressed in steps
+       *      - y          : the position of the point along the Y axis, expressed in steps
+       *      - motions    : the motions of the sequence
+       *      - numMotions : the number of motions already in the sequence (-1 if the planning already failed)
+       *
+       * - Return : the new number of motions, -1 if the sequence is full or the planning already failed
+       */
+      int planTravel(int x, int y, Motion motions[], int numMotions);
+
+      /**
+       * Append to a sequence the carry of a piece between two cells along the route of the pathPlanner, that
+       * avoids the pieces currently on the chessboard and in the cemeteries (as the navigate function)
+       *
+       * - Parameters :
+       *      - fromX      : the column of the source cell
+       *      - fromY      : the row of the source cell
+       *      - toX        : the column of the destination cell
+       *      - toY        : the row of the destination cell
+       *      - motions    : the motions of the sequence
+       *      - numMotions : the number of motions already in the sequence (-1 if the planning already failed)
+       *
+       * - Return : the new number of motions, -1 if there is not a route, the sequence is full or the planning
+       *            already failed
        */
-      void performMove(const char * type, const char * from, const char * to);
+      int planCarry(int fromX, int fromY, int toX, int toY, Motion motions[], int numMotions);
+
+      /**
+       * Execute a planned sequence with the CNC board powered once: the electromagnet is switched on for
+       * the carries and off for the travels. The blocks of the sequence are queued in the pipeline, that
+       * prints the time estimated by the MotionEstimator and the time measured when the sequence ends
+       *
+       * - Parameters :
+       *      - name       : the name of the sequence, shown with the times (es: "Capture")
+       *      - motions    : the motions of the sequence
+       *      - numMotions : the number of motions of the sequence
+       */
+      void execute(const char * name, Motion motions[], int numMotions);
 
       /**
        * Execute the process to remove a dead piece
@@ -159,6 +522,28 @@ class ChessBoard {
        */
       void updateState(const char * type, const char * oldPosition, const char * newPosition);
 
+      /**
+       * Save the state of the pieces and of the cells before the managers look for a candidate: the managers
+       * move the candidate (and mark the captured piece) while they validate the move
+       */
+      void saveState();
+
+      /**
+       * Bring the pieces and the cells back to the state saved by saveState, when a valid move cannot be
+       * performed by the pieces
+       */
+      void restoreState();
+
+      /**
+       * Update the cells of the ChessBoard involved in the movement of a piece of the player that has the turn
+       *
+       * - Parameters :
+       *      - type        : represents the type of the moved piece
+       *      - oldPosition : represents the old position of the moved piece
+       *      - newPosition : represents the new position of the moved piece
+       */
+      void updateCells(const char * type, const char * oldPosition, const char * newPosition);
+
       /**
        * Change the player turn
        *
@@ -169,9 +554,13 @@ class ChessBoard {
        * Private Chessboard variables
        *
        * cellsOccupied  : keep track of the state of the white and black pieces in the chessboard cells
-       * cemetery       : keep track of the state of the white and black cemetery spaces where the eliminated
-       *                  pawns are positioned (true = free space, false = busy space)
-       * solenoid       : keep track the position of the solenoid
+       * cemeteryManager: keep track of the white and black cemetery spaces where the eliminated pieces are
+       *                  positioned and choose the space of any captured piece
+       * solenoidX      : keep track the position of the solenoid along the X axis, expressed in steps from
+       *                  the center of the A1 cell (the X axis goes from the A to the H column)
+       * solenoidY      : keep track the position of the solenoid along the Y axis, expressed in steps from
+       *                  the center of the A1 cell (the Y axis goes from the 1 to the 8 row)
+       * cncPowered     : keep track if the CNC board is powered
        * turn           : keep track if moves the white (false) or the black (true)
        * bishopsManager : keep track the position of any bishop in the chessboard and manage any phase of a move
        *                  which involve a bishop
@@ -185,14 +574,40 @@ class ChessBoard {
        *                  which involve a rook
        * pawnsManager   : keep track the position of any pawn in the chessboard and manage any phase of a move
        *                  which involve a pawn
+       * moveGenerator  : generate the moves that a player can perform in the current position
+       * parser         : validate the hypotheses of the speech recognizer against the moves
+       * outcome        : the outcome of the last command
+       * ambiguous      : indicates if the hypotheses just rejected matched more moves, so the same command left
+       *                  to the parser of the words is ambiguous
+       * pathPlanner    : compute the routes of the pieces transported by the electromagnet avoiding the other pieces
+       * pipeline       : the queue of the blocks (movements, relays and waits) executed in background, it keeps
+       *                  the clock advanced by the delays of the stepper motors and of the relays
+       * saved*         : the state of the managers and of the cells before the last search of a candidate
        */
-      char * solenoid;
+      long solenoidX;
+      long solenoidY;
+      bool cncPowered;
       BishopsManager bishopsManager;
       KingsManager kingsManager;
       KnightsManager knightsManager;
       QueensManager queensManager;
       RooksManager rooksManager;
       PawnsManager pawnsManager;
+      CemeteryManager cemeteryManager;
+      MoveGenerator moveGenerator;
+      CommandParser parser;
+      int outcome;
+      bool ambiguous;
+      PathPlanner pathPlanner;
+      SetupPlanner setupPlanner;
+      MotionPipeline pipeline;
+      BishopsManager savedBishops;
+      KingsManager savedKings;
+      KnightsManager savedKnights;
+      QueensManager savedQueens;
+      RooksManager savedRooks;
+      PawnsManager savedPawns;
+      Cell savedCells[8][8];
 };
 
 #endif
@@ -0,0 +1,389 @@
+/*
+ * CommandParser class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CommandParser.h"
+#include <ctype.h>
+#include <string.h>
+
+using namespace std;
+
+// Words of the pieces, in the same order of their types
+static const char * PIECE_WORDS[] = {"PEDINA", "TORRE", "CAVALLO", "ALFIERE", "REGINA", "RE"};
+static const char PIECE_TYPES[] = "PRHBQK";
+
+// Word of a capture (es: PRENDE D5, CAVALLO PRENDE D5)
+#define CAPTURE_WORD "PRENDE"
+
+// Words between the piece and the cells (the preposition A is a single letter, as a column)
+static const char * PREPOSITIONS[] = {"DA", "IN", "SU", "AD"};
+#define NUM_PREPOSITIONS 4
+
+// Fields of the moves compared by the filter
+#define FILTER_FROM 0
+#define FILTER_TO 1
+#define FILTER_FILE 2
+#define FILTER_CAPTURE 3
+#define FILTER_FROM_FILE 4
+#define FILTER_FROM_RANK 5
+#define FILTER_PIECE 6
+
+// Letters of the pieces in algebraic notation and the corresponding types (the knight is N)
+static const char NOTATION_LETTERS[] = "NBRQK";
+static const char NOTATION_TYPES[] = "HBRQK";
+
+// Type of the piece named by a letter of the algebraic notation, '\0' if the letter is not a piece
+static char notationType(char letter){
+  const char * found = strchr(NOTATION_LETTERS, letter);
+  return letter != '\0' && found != NULL ? NOTATION_TYPES[found - NOTATION_LETTERS] : '\0';
+}
+
+// Type of the piece named by a word, '\0' if the word is not a piece
+static char pieceType(const char * word){
+  for(int i = 0; i < 6; i++){
+    if(strcmp(word, PIECE_WORDS[i]) == 0){
+      return PIECE_TYPES[i];
+    }
+  }
+  return '\0';
+}
+
+// Constructor
+CommandParser::CommandParser(){
+  numMoves = 0;
+  matches = -1;
+  armed = false;
+  active = false;
+};
+
+void CommandParser::reset(Move moves[], int numMoves, bool turn){
+  load(moves, numMoves, turn);
+  armed = true;
+};
+
+void CommandParser::load(Move moves[], int numMoves, bool turn){
+  memcpy(this->moves, moves, numMoves * sizeof(Move));
+  this->numMoves = numMoves;
+  this->turn = turn;
+  armed = false;
+  active = false;
+};
+
+bool CommandParser::resolve(const char * command, char frame[MOVE_FRAME_SIZE]){
+  begin();
+  for(; *command != '\0'; command++){
+    push(*command);
+  }
+  return finish(frame);
+};
+
+void CommandParser::push(char c){
+  if(!active){
+    if(!armed){
+      return;
+    }
+    // the first byte of the command: the parsing starts from the first word
+    armed = false;
+    begin();
+  }
+  if(!valid){
+    return;
+  }
+
+  if(c == ' ' || c == '\n' || c == '\r'){
+    if(tokenLength > 0){
+      endToken();
+    }
+  } else if(tokenLength < TOKEN_SIZE - 1){
+    raw[tokenLength] = c;
+    token[tokenLength++] = toupper(c);
+  } else {
+    // no word of a move is so long
+    valid = false;
+  }
+};
+
+bool CommandParser::finish(char frame[MOVE_FRAME_SIZE]){
+  if(!active){
+    return false;
+  }
+  active = false;
+  matches = -1;
+  if(valid && tokenLength > 0){
+    endToken();
+  }
+
+  if(valid && castling != '\0'){
+    // the castling is not generated as a move: the manager of the king verifies it
+    char from[3] = {'E', turn ? '8' : '1', '\0'};
+    char to[3] = {castling, from[1], '\0'};
+    matches = 1;
+    return MoveFrame::encode('K', from, to, 'Q', frame);
+  }
+
+  if(valid && file != '\0'){
+    if(numCells == 0){
+      // the last word is a column: the destination is in that column (es: TORRE D)
+      numToFirst = filter(toFirst, numToFirst, FILTER_FILE, file - 'A');
+    } else if(file != 'A'){
+      valid = false;
+    }
+  }
+  // at least the destination cell, its column or a capture must be expressed
+  if(!valid || (numCells == 0 && file == '\0' && !capture)){
+    return false;
+  }
+
+  // a destination alone in lowercase is the move of a pawn in SAN (es: e4 with a knight in C3), while in
+  // uppercase it is a command that more pieces can perform
+  if(numTokens == 1 && numCells == 1 && lowercase){
+    numToFirst = filter(toFirst, numToFirst, FILTER_PIECE, 'P');
+  }
+
+  int count = numCells == 2 ? numFromFirst : numToFirst;
+  matches = count;
+  if(count != 1){
+    return false;
+  }
+  Move found = moves[numCells == 2 ? fromFirst[0] : toFirst[0]];
+  char from[3] = {(char) ('A' + found.from / 8), (char) ('1' + found.from % 8), '\0'};
+  char to[3] = {(char) ('A' + found.to / 8), (char) ('1' + found.to % 8), '\0'};
+
+  // the type of the new piece can be chosen only when a pawn reaches the last row
+  if(promotion != '\0' && (found.piece != 'P' || (to[1] != '1' && to[1] != '8'))){
+    return false;
+  }
+  return MoveFrame::encode(found.piece, from, to, promotion != '\0' ? promotion : 'Q', frame);
+};
+
+int CommandParser::getMatches(){
+  return matches;
+};
+
+void CommandParser::begin(){
+  active = true;
+  valid = true;
+  tokenLength = 0;
+  numTokens = 0;
+  numCells = 0;
+  piece = '\0';
+  promotion = '\0';
+  file = '\0';
+  capture = false;
+  castling = '\0';
+  notation = false;
+  lowercase = false;
+};
+
+void CommandParser::endToken(){
+  token[tokenLength] = '\0';
+  raw[tokenLength] = '\0';
+  tokenLength = 0;
+  numTokens++;
+
+  bool cell = strlen(token) == 2 && token[0] >= 'A' && token[0] <= 'H' && token[1] >= '1' && token[1] <= '8';
+  bool letter = strlen(token) == 1 && token[0] >= 'A' && token[0] <= 'H';
+  char type = pieceType(token);
+
+  if(numTokens == 1){
+    // the command starts with the piece, the destination or the capture: all the moves of the piece are candidates
+    bool voice = type != '\0' || cell || strcmp(token, CAPTURE_WORD) == 0;
+    lowercase = cell && islower(raw[0]);
+    piece = voice ? type : '\0';
+    numToFirst = 0;
+    for(int i = 0; i < numMoves; i++){
+      if(piece == '\0' || moves[i].piece == piece){
+        toFirst[numToFirst++] = i;
+      }
+    }
+    numFromFirst = numToFirst;
+    memcpy(fromFirst, toFirst, numToFirst);
+    if(!voice){
+      notation = true;
+      valid = parseNotation(raw);
+      return;
+    }
+    if(type != '\0'){
+      return;
+    }
+  }
+
+  // a move in algebraic notation is a single word
+  if(notation){
+    valid = false;
+    return;
+  }
+
+  // a single letter is a column only if it is the last word, otherwise it can be just the preposition A
+  if(file != '\0' && file != 'A'){
+    valid = false;
+    return;
+  }
+  file = '\0';
+
+  if(cell && numCells < 2 && promotion == '\0'){
+    cells[numCells] = (token[0] - 'A') * 8 + token[1] - '1';
+    if(numCells == 0){
+      // the cell can be the destination (PIECE PREP CELL) or the source (PIECE PREP CELL PREP CELL)
+      numToFirst = filter(toFirst, numToFirst, FILTER_TO, cells[0]);
+      numFromFirst = filter(fromFirst, numFromFirst, FILTER_FROM, cells[0]);
+    } else {
+      numFromFirst = filter(fromFirst, numFromFirst, FILTER_TO, cells[1]);
+    }
+    numCells++;
+  } else if(strcmp(token, CAPTURE_WORD) == 0 && !capture && promotion == '\0'){
+    capture = true;
+    numToFirst = filter(toFirst, numToFirst, FILTER_CAPTURE, 0);
+    numFromFirst = filter(fromFirst, numFromFirst, FILTER_CAPTURE, 0);
+  } else if(type != '\0' && type != 'P' && type != 'K' && numCells > 0 && promotion == '\0'){
+    // the type of the new piece follows the destination (the word of a piece before a cell is a promoted pawn,
+    // left to the parser of the words)
+    promotion = type;
+  } else if(letter && promotion == '\0'){
+    file = token[0];
+  } else if(type != '\0' || cell || !isPreposition(token)){
+    valid = false;
+  }
+};
+
+bool CommandParser::parseNotation(const char * word){
+  int length = strlen(word);
+  char type = 'P';
+  int start = 0;
+
+  // the check, the mate and the comments (+, #, !, ?) are not part of the move
+  while(length > 0 && strchr("+#!?", word[length - 1]) != NULL){
+    length--;
+  }
+
+  // castling (O-O toward the G column, O-O-O toward the C column, also written with zeros)
+  if((length == 3 || length == 5) && (strncmp(word, "O-O-O", length) == 0 || strncmp(word, "0-0-0", length) == 0)){
+    castling = length == 3 ? 'G' : 'C';
+    return true;
+  }
+
+  // UCI: source, destination and the letter of the new piece in lowercase (es: g1f3, e7e8q)
+  if((length == 4 || length == 5) && word[0] >= 'a' && word[0] <= 'h' && word[1] >= '1' && word[1] <= '8' &&
+     word[2] >= 'a' && word[2] <= 'h' && word[3] >= '1' && word[3] <= '8'){
+    if(length == 5){
+      promotion = notationType(toupper(word[4]));
+      if(promotion == '\0' || promotion == 'K'){
+        return false;
+      }
+    }
+    cells[0] = (word[0] - 'a') * 8 + word[1] - '1';
+    cells[1] = (word[2] - 'a') * 8 + word[3] - '1';
+    numCells = 2;
+    numFromFirst = filter(fromFirst, numFromFirst, FILTER_FROM, cells[0]);
+    numFromFirst = filter(fromFirst, numFromFirst, FILTER_TO, cells[1]);
+    // the castling is written as the move of the king
+    if(numFromFirst == 0 && (cells[0] == 4 * 8 + (turn ? 7 : 0)) && cells[1] % 8 == cells[0] % 8 &&
+       (cells[1] / 8 == 6 || cells[1] / 8 == 2)){
+      castling = 'A' + cells[1] / 8;
+    }
+    return true;
+  }
+
+  // SAN: [piece][column][row][x]destination[=new piece] (es: Nf3, Nbd7, exd5, e8=Q)
+  if(length > 0 && notationType(word[0]) != '\0'){
+    type = notationType(word[0]);
+    start = 1;
+  }
+  if(type == 'P' && length >= 3 && notationType(word[length - 1]) != '\0'){
+    promotion = notationType(word[length - 1]);
+    length -= word[length - 2] == '=' ? 2 : 1;
+    if(promotion == 'K'){
+      return false;
+    }
+  }
+  if(length - start < 2 || word[length - 2] < 'a' || word[length - 2] > 'h' || word[length - 1] < '1' || word[length - 1] > '8'){
+    return false;
+  }
+  cells[0] = (word[length - 2] - 'a') * 8 + word[length - 1] - '1';
+  numCells = 1;
+  length -= 2;
+  if(length > start && word[length - 1] == 'x'){
+    capture = true;
+    length--;
+  }
+  // the column and the row of the source, when the destination can be reached by more pieces
+  if(length - start > 2){
+    return false;
+  }
+
+  numToFirst = filter(toFirst, numToFirst, FILTER_TO, cells[0]);
+  numToFirst = filter(toFirst, numToFirst, FILTER_PIECE, type);
+  if(capture){
+    numToFirst = filter(toFirst, numToFirst, FILTER_CAPTURE, 0);
+  }
+  for(int i = start; i < length; i++){
+    if(word[i] >= 'a' && word[i] <= 'h'){
+      numToFirst = filter(toFirst, numToFirst, FILTER_FROM_FILE, word[i] - 'a');
+    } else if(word[i] >= '1' && word[i] <= '8'){
+      numToFirst = filter(toFirst, numToFirst, FILTER_FROM_RANK, word[i] - '1');
+    } else {
+      return false;
+    }
+  }
+  return true;
+};
+
+bool CommandParser::isPreposition(const char * word){
+  for(int i = 0; i < NUM_PREPOSITIONS; i++){
+    if(strcmp(word, PREPOSITIONS[i]) == 0){
+      return true;
+    }
+  }
+  return false;
+};
+
+int CommandParser::filter(unsigned char list[], int count, int field, int value){
+  int kept = 0;
+
+  for(int i = 0; i < count; i++){
+    Move candidate = moves[list[i]];
+    bool match;
+
+    switch(field){
+      case FILTER_FROM:
+        match = candidate.from == value;
+        break;
+      case FILTER_TO:
+        match = candidate.to == value;
+        break;
+      case FILTER_FILE:
+        match = candidate.to / 8 == value;
+        break;
+      case FILTER_FROM_FILE:
+        match = candidate.from / 8 == value;
+        break;
+      case FILTER_FROM_RANK:
+        match = candidate.from % 8 == value;
+        break;
+      case FILTER_PIECE:
+        match = candidate.piece == value;
+        break;
+      default:
+        match = candidate.capture;
+        break;
+    }
+    if(match){
+      list[kept++] = list[i];
+    }
+  }
+  return kept;
+};
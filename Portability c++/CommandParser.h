@@ -0,0 +1,217 @@
+/*
+ * Header file for the CommandParser class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMANDPARSER_H
+#define COMMANDPARSER_H
+
+#include "MoveFrame.h"
+#include "MoveGenerator.h"
+
+// Longest word of a move command (es: CAVALLO, exd8=Q+!), the terminator included
+#define TOKEN_SIZE 10
+
+// Separator of the hypotheses of the speech recognizer sent in a single command, the most likely first
+// (es: PEDINA A E4|PEDINA A E5)
+#define HYPOTHESIS_SEPARATOR '|'
+
+// Maximum number of hypotheses considered for a command
+#define MAX_HYPOTHESES 8
+
+// Longest hypothesis of a move, the separator included (es: PEDINA DA E7 A E8 ALFIERE|)
+#define MAX_SENTENCE 30
+
+class CommandParser {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, that does not parse any command until reset
+         */
+        CommandParser();
+
+        /**
+         * Load the moves that the player that has the turn can perform: the next command that starts is parsed
+         * against them (the following ones are not, since the position will have changed)
+         *
+         * - Parameters :
+         *      - moves    : the moves generated by the MoveGenerator for the current position
+         *      - numMoves : the number of moves
+         *      - turn     : indicates if moves the white (false) or the black (true)
+         */
+        void reset(Move moves[], int numMoves, bool turn);
+
+        /**
+         * Load the moves that the player that has the turn can perform, without parsing the next command that
+         * starts (the moves are used by resolve)
+         *
+         * - Parameters :
+         *      - moves    : the moves generated by the MoveGenerator for the current position
+         *      - numMoves : the number of moves
+         *      - turn     : indicates if moves the white (false) or the black (true)
+         */
+        void load(Move moves[], int numMoves, bool turn);
+
+        /**
+         * Parse a complete command against the loaded moves, as if its bytes arrived now
+         *
+         * - Parameters :
+         *      - command : the command, without the terminator
+         *      - frame   : filled with the move encoded as a binary frame (see MoveFrame)
+         *
+         * - Return : true if the command has been resolved to a single move
+         */
+        bool resolve(const char * command, char frame[MOVE_FRAME_SIZE]);
+
+        /**
+         * Advance the parsing with a byte of the command being received: when a word is complete the moves that
+         * do not match it are discarded, so the candidates are already known when the last word arrives
+         * (es: PEDINA discards the moves of the other pieces, E4 the ones that do not reach E4 or leave it).
+         * Besides the complete commands (PEDINA DA E2 A E4), the partial ones are resolved if a single move
+         * matches them: the destination only (E4), a capture (PRENDE D5, CAVALLO PRENDE D5), a piece and the
+         * column of the destination (TORRE D), the source and the destination (E2 E4).
+         * A command of a single word can also be a move in algebraic notation, as written by the chess programs:
+         * SAN (Nf3, exd5, e8=Q, O-O) or UCI (g1f3, e7e8q)
+         *
+         * - Parameters :
+         *      - c : the received byte (a space separates two words)
+         */
+        void push(char c);
+
+        /**
+         * End the command being received and verify if it is a move that only a piece can perform
+         * N.B.: a command that is not a move (es: CHECK), that contains unknown words or that matches no move
+         *       or more than one is left to the parser of the words, that reports the error
+         *
+         * - Parameters :
+         *      - frame : filled with the move encoded as a binary frame (see MoveFrame)
+         *
+         * - Return : true if the command has been resolved to a single move
+         */
+        bool finish(char frame[MOVE_FRAME_SIZE]);
+
+        /**
+         * Get the number of moves matched by the last command parsed
+         *
+         * - Return : the number of moves, -1 if the command is not a move
+         */
+        int getMatches();
+
+    private:
+        /**
+         * Start the parsing of a command from its first word
+         */
+        void begin();
+
+        /**
+         * Analyze a complete word of the command
+         */
+        void endToken();
+
+        /**
+         * Parse the first word of a command as a move in SAN or UCI notation, filtering the candidates
+         * N.B.: the case of the letters matters (Bc4 is a bishop, bc4 a pawn of the B column)
+         *
+         * - Parameters :
+         *      - word : the word as received
+         *
+         * - Return : false if the word is not a move in SAN or UCI notation
+         */
+        bool parseNotation(const char * word);
+
+        /**
+         * Verify if a word can separate the piece and the cells (es: DA)
+         *
+         * - Parameters :
+         *      - word : the word
+         *
+         * - Return : true if the word is a preposition
+         */
+        bool isPreposition(const char * word);
+
+        /**
+         * Keep only the candidates that match a word of the command
+         *
+         * - Parameters :
+         *      - list  : the indexes of the moves to filter, the list is compacted
+         *      - count : the number of indexes in the list
+         *      - field : the field compared: FILTER_FROM, FILTER_TO (the cell expressed as row * 8 + col),
+         *                FILTER_FILE (the column of the destination, 0 for A), FILTER_FROM_FILE (the column of
+         *                the source), FILTER_FROM_RANK (the row of the source, 0 for 1), FILTER_PIECE (the type
+         *                of the piece) or FILTER_CAPTURE (no value)
+         *      - value : the value of the field
+         *
+         * - Return : the number of indexes left in the list
+         */
+        int filter(unsigned char list[], int count, int field, int value);
+
+        /**
+         * Private variables
+         *
+         * moves         : the moves of the player that has the turn
+         * numMoves      : the number of moves
+         * turn          : the player that performs the moves
+         * armed         : indicates if the next command is parsed (the moves are of the current position)
+         * active        : indicates if the command being received is parsed
+         * valid         : indicates if the command received so far can be a move
+         * token         : the word being received, in uppercase
+         * raw           : the word being received, as received
+         * tokenLength   : the bytes of the word being received
+         * numTokens     : the number of complete words
+         * piece         : the type of the moved piece (same chars used by the Cell class), '\0' if not expressed
+         * promotion     : the type of the new piece chosen by the player, '\0' if not expressed
+         * file          : the last word, if it is a single letter (a column or the preposition A)
+         * capture       : indicates if the command is a capture
+         * castling      : the column of the destination of the king for a castling in algebraic notation ('G'
+         *                 or 'C'), '\0' otherwise
+         * notation      : indicates if the command is a move in algebraic notation
+         * lowercase     : indicates if the first word is a cell in lowercase (a pawn move in SAN if it is alone)
+         * cells         : the cells in the command expressed as row * 8 + col
+         * numCells      : the number of cells in the command
+         * toFirst       : the indexes of the moves that reach the first cell (if the command has one cell or none)
+         * numToFirst    : the number of moves in toFirst
+         * fromFirst     : the indexes of the moves that leave the first cell (then the ones that reach the second one)
+         * numFromFirst  : the number of moves in fromFirst
+         * matches       : the number of moves matched by the last command, -1 if it is not a move
+         */
+        Move moves[MAX_MOVES];
+        int numMoves;
+        bool turn;
+        bool armed;
+        bool active;
+        bool valid;
+        char token[TOKEN_SIZE];
+        char raw[TOKEN_SIZE];
+        int tokenLength;
+        int numTokens;
+        char piece;
+        char promotion;
+        char file;
+        bool capture;
+        char castling;
+        bool notation;
+        bool lowercase;
+        int cells[2];
+        int numCells;
+        unsigned char toFirst[MAX_MOVES];
+        int numToFirst;
+        unsigned char fromFirst[MAX_MOVES];
+        int numFromFirst;
+        int matches;
+};
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * CommandQueue class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CommandQueue.h"
+
+using namespace std;
+
+// Constructor
+CommandQueue::CommandQueue(){
+  head = 0;
+  tail = 0;
+  sem_init(&queued, 0, 0);
+  sem_init(&vacant, 0, COMMAND_QUEUE_SIZE - 1);
+};
+
+void CommandQueue::push(const ParsedCommand & command){
+  // the queue is full: wait for the consumer to free a place
+  while(sem_wait(&vacant) != 0);
+  commands[head] = command;
+  // the command must be written before it is published to the consumer
+  __sync_synchronize();
+  head = (head + 1) % COMMAND_QUEUE_SIZE;
+  sem_post(&queued);
+};
+
+void CommandQueue::pop(ParsedCommand * command){
+  // the queue is empty: wait for the producer to append a command
+  while(sem_wait(&queued) != 0);
+  // the command is read only after its place has been published
+  __sync_synchronize();
+  *command = commands[tail];
+  // the place must be read before it is given back to the producer
+  __sync_synchronize();
+  tail = (tail + 1) % COMMAND_QUEUE_SIZE;
+  sem_post(&vacant);
+};
+
+bool CommandQueue::available(){
+  return head != tail;
+};
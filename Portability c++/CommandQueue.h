@@ -0,0 +1,79 @@
+/*
+ * Header file for the CommandQueue class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include "ParsedCommand.h"
+#include <semaphore.h>
+
+// Number of places of the queue (a place is always free, so it keeps COMMAND_QUEUE_SIZE - 1 commands)
+#define COMMAND_QUEUE_SIZE 16
+
+class CommandQueue {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with no command
+         */
+        CommandQueue();
+
+        /**
+         * Append a parsed command, copying it into the next free place: it is called only by the thread that
+         * reads the commands, that sleeps while the queue is full (the next bytes wait in the stream)
+         *
+         * - Parameters :
+         *      - command : the command, parsed as soon as it has been read
+         */
+        void push(const ParsedCommand & command);
+
+        /**
+         * Take the oldest command, sleeping until a command arrives: it is called only by the thread that
+         * executes the commands
+         *
+         * - Parameters :
+         *      - command : filled with the command
+         */
+        void pop(ParsedCommand * command);
+
+        /**
+         * Verify if a command is waiting, without taking it and without waiting
+         *
+         * - Return : true if the queue is not empty
+         */
+        bool available();
+
+    private:
+        /**
+         * Private variables
+         *
+         * commands : the places of the commands
+         * head     : the place of the next command (written only by push)
+         * tail     : the place of the oldest command (written only by pop)
+         * queued   : the number of commands in the queue, the consumer sleeps on it
+         * vacant   : the number of free places, the producer sleeps on it
+         */
+        ParsedCommand commands[COMMAND_QUEUE_SIZE];
+        volatile unsigned int head;
+        volatile unsigned int tail;
+        sem_t queued;
+        sem_t vacant;
+};
+
+#endif
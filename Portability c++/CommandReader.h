@@ -0,0 +1,183 @@
+/*
+ * Header file for the CommandReader class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMANDREADER_H
+#define COMMANDREADER_H
+
+#include "CommandParser.h"
+#include "MoveFrame.h"
+
+class ByteCapture;
+
+// Longest command, terminator included: all the hypotheses of the speech recognizer, each one as long as the
+// longest sentence (a FEN command is shorter)
+#define COMMAND_SIZE (MAX_HYPOTHESES * MAX_SENTENCE)
+
+// Number of complete commands waiting for the parser
+#define COMMAND_SLOTS 4
+
+// Terminator of a command sent by the speech source ('\n' is accepted too)
+#define COMMAND_TERMINATOR '#'
+
+class CommandReader {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with no command received
+         */
+        CommandReader();
+
+        /**
+         * Add a received byte to the command being framed: when the terminator arrives the command is complete
+         * and it is appended to the ring of the commands waiting for the parser. It never waits, so it can be
+         * called for any byte available (or by the interrupt of the serial port).
+         * The bytes with the most significant bit set belong to the binary move frames (see MoveFrame): a frame
+         * is complete after MOVE_FRAME_SIZE bytes, without terminator, and it is appended to the same ring (so the
+         * commands are taken in the order they have been sent) only if its CRC is valid
+         * N.B.: a command longer than COMMAND_SIZE - 1 bytes, or completed when the ring is full (the caller
+         *       should not receive bytes while full is true), is discarded as a whole
+         *
+         * - Parameters :
+         *      - c : the received byte
+         */
+        void receive(char c);
+
+        /**
+         * Take the oldest complete command
+         *
+         * - Parameters :
+         *      - command : filled with the command, without the terminator (a frame is followed by '\0')
+         *
+         * - Return : false if no command is complete
+         */
+        bool next(char command[COMMAND_SIZE]);
+
+        /**
+         * Verify if a complete command is waiting, without taking it
+         *
+         * - Return : true if a command is complete
+         */
+        bool available();
+
+        /**
+         * Verify if the ring of the complete commands is full: the bytes should be left in the buffer of the
+         * serial port (or of the kernel) until the parser takes a command, otherwise the next command is lost
+         *
+         * - Return : true if no more command can be appended
+         */
+        bool full();
+
+        /**
+         * Verify if no command is being received or waiting for the parser, so a command that starts now is
+         * executed in the current position
+         *
+         * - Return : true if nothing has been received since the last command taken
+         */
+        bool idle();
+
+        /**
+         * Parse the text commands while their bytes arrive: when the terminator arrives, a command that the
+         * parser resolves to a single move is appended to the ring as the equivalent binary frame
+         *
+         * - Parameters :
+         *      - parser : the parser fed with the bytes of the text commands, NULL to disable it
+         */
+        void setParser(CommandParser * parser);
+
+#ifndef ARDUINO
+        /**
+         * Receive the bytes available on a file descriptor (es: the master side of a pty) without waiting. The
+         * bytes are read one at a time and the reading stops when the ring is full, so the rest of the commands
+         * waits in the kernel
+         *
+         * - Parameters :
+         *      - fd     : the non blocking file descriptor
+         *      - single : stop also when a command is complete, so a command discarded by the reader is always
+         *                 the last one received (es: to reply to the commands in order)
+         *
+         * - Return : the number of bytes received, -1 if the other side has been closed
+         */
+        int receiveFrom(int fd, bool single);
+
+        /**
+         * Record the bytes received from a file descriptor, with their time, so the commands can be replayed
+         *
+         * - Parameters :
+         *      - capture : the open capture file, NULL to stop the recording
+         */
+        void setCapture(ByteCapture * capture);
+#endif
+
+        /**
+         * Get the number of commands discarded because they were too long or the ring was full, and of the
+         * frames discarded because they were truncated or corrupted
+         *
+         * - Return : the number of discarded commands
+         */
+        int getDiscarded();
+
+    private:
+        /**
+         * Receive a byte of a binary move frame
+         *
+         * - Parameters :
+         *      - c : the received byte
+         */
+        void receiveFrame(char c);
+
+        /**
+         * Append a complete command (or frame) to the ring
+         *
+         * - Parameters :
+         *      - command : the bytes of the command
+         *      - length  : the number of bytes
+         */
+        void push(const char * command, int length);
+
+        /**
+         * Private variables
+         *
+         * commands    : the ring of the complete commands
+         * head        : the place of the next complete command (written only by receive)
+         * tail        : the place of the oldest complete command (written only by next)
+         * partial     : the command being framed
+         * length      : the bytes of the command being framed
+         * dropping    : indicates if the command being framed is discarded
+         * parser      : the parser fed with the bytes of the text commands, NULL if disabled
+         * frame       : the frame being received
+         * frameLength : the bytes of the frame being received (0 if no frame is being received)
+         * discarded   : the number of discarded commands
+         * capture     : the capture file of the bytes received from a file descriptor, NULL if they are not recorded
+         */
+        char commands[COMMAND_SLOTS][COMMAND_SIZE];
+        volatile unsigned char head;
+        volatile unsigned char tail;
+        char partial[COMMAND_SIZE];
+        int length;
+        bool dropping;
+        CommandParser * parser;
+        char frame[MOVE_FRAME_SIZE];
+        int frameLength;
+        int discarded;
+#ifndef ARDUINO
+        ByteCapture * capture;
+#endif
+};
+
+#endif
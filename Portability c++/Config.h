@@ -44,4 +44,24 @@
 // Number of steps to cross a cell and go to the next
 #define STEPS 130
 
+// Half period of a step pulse (us) and delay after a change of direction of a stepper motor (ms)
+#define STEP_DELAY 800
+#define DIR_DELAY 50
+
+// Time (ms) waited by the CNC shield V3 to power up, time (ms) waited for the stepper motors to finish before
+// powering it off and time (ms) needed by a relay to switch
+#define POWER_UP_DELAY 1000
+#define FINISH_DELAY 500
+#define RELAY_DELAY 10
+
+// Size (mm) of a cell, for the G-code sent to an external controller (GRBL $100 = $101 = STEPS / CELL_SIZE)
+#define CELL_SIZE 50
+
+// Number of columns of cells of any cemetery (8 cells each, one for each row of the chessboard): the white
+// cemetery is on the left of the A column, the black cemetery is on the right of the H column
+#define CEMETERY_COLUMNS 2
+
+// Number of steps performed by the idle drift of the solenoid between two checks for a new command
+#define DRIFT_CHUNK 13
+
 #endif
@@ -0,0 +1,220 @@
+/*
+ * Fake GRBL controller on a pty
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The fake controller behaves as GRBL toward the G-code backend: the received bytes wait in a receive buffer of
+ * RX_BUFFER_SIZE bytes, a line is acknowledged ("ok") when it moves into a planner of PLANNER_SIZE movements and
+ * the planner executes the movements in real time (divided by the speed up). A dwell (G4) waits for the planner
+ * to be empty, as in GRBL. It prints the path of its pty and, when the backend disconnects, the lines received
+ * and the largest use of the receive buffer, so an overflow of the flow control is detected:
+ *
+ *      make build/FakeGrbl
+ *      build/FakeGrbl [speed up] &
+ *      dist/Debug/GNU-Linux/portability_c__ -g <pty>
+ */
+
+#include "GcodeStreamer.h"
+#include <fcntl.h>
+#include <math.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Number of movements in the planner of GRBL
+#define PLANNER_SIZE 16
+
+// Speed (mm/min) of the G0 movements
+#define RAPID_RATE 20000.0
+
+// Current time (us)
+static unsigned long long micros(){
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * 1000000ULL + now.tv_nsec / 1000;
+}
+
+// Read a word (es: X12.5) of a line of G-code
+static bool word(const char * line, char letter, double * value){
+  for(const char * c = line; *c != '\0'; c++){
+    if(*c == letter){
+      *value = atof(c + 1);
+      return true;
+    }
+  }
+  return false;
+}
+
+int main(int argc, char * argv[]){
+  double speedUp = argc > 1 ? atof(argv[1]) : 10.0;
+  char rx[RX_BUFFER_SIZE * 4];
+  int rxLength = 0;
+  int maxBuffered = 0;
+  int overflows = 0;
+  int lines = 0;
+  int errors = 0;
+  bool connected = false;
+  // durations (us) of the movements in the planner, the first one is being executed since plannerStart
+  unsigned long long planner[PLANNER_SIZE];
+  int plannerFirst = 0;
+  int plannerLength = 0;
+  unsigned long long plannerStart = 0;
+  unsigned long long motionTime = 0;
+  double x = 0;
+  double y = 0;
+  double feed = RAPID_RATE;
+  struct termios options;
+
+  if(speedUp <= 0){
+    speedUp = 1;
+  }
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+    perror("posix_openpt");
+    return 1;
+  }
+  // the slave stays open (and raw) so the pty survives until the backend connects
+  int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+  if(slave < 0 || tcgetattr(slave, &options) != 0){
+    perror("pty");
+    return 1;
+  }
+  cfmakeraw(&options);
+  tcsetattr(slave, TCSANOW, &options);
+  printf("%s\n", ptsname(master));
+  fflush(stdout);
+
+  const char * welcome = "\r\nGrbl 1.1f ['$' for help]\r\n";
+  if(write(master, welcome, strlen(welcome)) < 0){
+    return 1;
+  }
+
+  while(true){
+    unsigned long long now = micros();
+
+    // the first movement of the planner is over
+    if(plannerLength > 0 && now - plannerStart >= planner[plannerFirst]){
+      plannerStart += planner[plannerFirst];
+      plannerFirst = (plannerFirst + 1) % PLANNER_SIZE;
+      plannerLength--;
+      continue;
+    }
+
+    // the lines move from the receive buffer to the planner, a dwell waits for the planner to be empty
+    char * end = (char *) memchr(rx, '\n', rxLength);
+    bool dwell = rxLength >= 2 && strncmp(rx, "G4", 2) == 0;
+    if(end != NULL && plannerLength < PLANNER_SIZE && !(dwell && plannerLength > 0)){
+      int length = end - rx + 1;
+      double value;
+      char line[GCODE_LINE_SIZE];
+      unsigned long long duration = 0;
+
+      snprintf(line, sizeof(line), "%.*s", length - 1, rx);
+      memmove(rx, rx + length, rxLength - length);
+      rxLength -= length;
+      lines++;
+
+      if(strncmp(line, "G0", 2) == 0 || strncmp(line, "G1", 2) == 0){
+        double toX = word(line, 'X', &value) ? value : x;
+        double toY = word(line, 'Y', &value) ? value : y;
+        double rate = RAPID_RATE;
+        if(line[1] == '1'){
+          if(word(line, 'F', &value)){
+            feed = value;
+          }
+          rate = feed;
+        }
+        duration = (unsigned long long) (sqrt((toX - x) * (toX - x) + (toY - y) * (toY - y)) / rate * 60e6 / speedUp);
+        x = toX;
+        y = toY;
+      } else if(dwell){
+        // the dwell is acknowledged at its end
+        unsigned long long pause = (unsigned long long) ((word(line, 'P', &value) ? value : 0) * 1e6 / speedUp);
+        usleep(pause);
+        motionTime += pause;
+      } else if(strncmp(line, "G92", 3) == 0){
+        x = word(line, 'X', &value) ? value : x;
+        y = word(line, 'Y', &value) ? value : y;
+      } else if(line[0] != 'G' && line[0] != 'M'){
+        errors++;
+        if(write(master, "error:20\r\n", 10) < 0){
+          break;
+        }
+        continue;
+      }
+      if(duration > 0){
+        if(plannerLength == 0){
+          plannerStart = now;
+        }
+        planner[(plannerFirst + plannerLength) % PLANNER_SIZE] = duration;
+        plannerLength++;
+        motionTime += duration;
+      }
+      if(write(master, "ok\r\n", 4) < 0){
+        break;
+      }
+      continue;
+    }
+
+    // wait for new bytes or for the end of the current movement
+    struct pollfd input = {master, POLLIN, 0};
+    int timeout = plannerLength > 0 ? (int) ((planner[plannerFirst] - (now - plannerStart)) / 1000) + 1 : -1;
+    if(poll(&input, 1, timeout) <= 0){
+      continue;
+    }
+    if(input.revents & POLLHUP){
+      // the backend has disconnected
+      if(connected){
+        break;
+      }
+      usleep(1000);
+      continue;
+    }
+    int received = read(master, rx + rxLength, sizeof(rx) - rxLength);
+    if(received <= 0){
+      if(connected){
+        break;
+      }
+      continue;
+    }
+    if(slave >= 0){
+      // the backend has connected: the pty is closed when it disconnects
+      close(slave);
+      slave = -1;
+      connected = true;
+    }
+    rxLength += received;
+    if(rxLength > maxBuffered){
+      maxBuffered = rxLength;
+    }
+    if(rxLength > RX_BUFFER_SIZE){
+      overflows++;
+    }
+  }
+
+  // the time of the movements is reported without the speed up
+  printf("%d lines, %d errors, largest receive buffer %d bytes, %d overflows, motion %llu ms\n", lines, errors, maxBuffered,
+         overflows, (unsigned long long) (motionTime * speedUp / 1000));
+  return overflows > 0 ? 2 : 0;
+}
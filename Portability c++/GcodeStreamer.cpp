@@ -0,0 +1,167 @@
+/*
+ * GcodeStreamer class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GcodeStreamer.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Constructor
+GcodeStreamer::GcodeStreamer(){
+  fd = -1;
+  firstPending = 0;
+  numPending = 0;
+  buffered = 0;
+  x = 0;
+  y = 0;
+  magnet = false;
+  lines = 0;
+};
+
+bool GcodeStreamer::open(const char * device, long x, long y){
+  struct termios options;
+  char line[GCODE_LINE_SIZE];
+
+  fd = ::open(device, O_RDWR | O_NOCTTY);
+  if(fd < 0){
+    return false;
+  }
+  // raw 8N1 at the default baud rate of GRBL (a pty ignores it)
+  if(tcgetattr(fd, &options) == 0){
+    cfmakeraw(&options);
+    cfsetispeed(&options, B115200);
+    cfsetospeed(&options, B115200);
+    tcsetattr(fd, TCSANOW, &options);
+  }
+
+  this->x = x;
+  this->y = y;
+  sendLine("G21 G90");
+  snprintf(line, GCODE_LINE_SIZE, "G92 X%.2f Y%.2f", millimeters(x), millimeters(y));
+  sendLine(line);
+  sendLine("M5");
+  return true;
+};
+
+bool GcodeStreamer::isOpen(){
+  return fd >= 0;
+};
+
+void GcodeStreamer::send(Block block){
+  char line[GCODE_LINE_SIZE];
+
+  if(fd < 0){
+    return;
+  }
+
+  if(block.type == BLOCK_MOVE){
+    // dirX = true moves the solenoid toward the H column, dirY = true toward the 1 row
+    if(block.target & MOVE_X){
+      x += block.dirX ? block.count : -block.count;
+    }
+    if(block.target & MOVE_Y){
+      y += block.dirY ? -block.count : block.count;
+    }
+    if(magnet){
+      // a step every 2 * STEP_DELAY us, as the stepper motors driven by the board
+      double feed = 60.0 * 1000000.0 / (2.0 * STEP_DELAY) * CELL_SIZE / STEPS;
+      snprintf(line, GCODE_LINE_SIZE, "G1 X%.2f Y%.2f F%.0f", millimeters(x), millimeters(y), feed);
+    } else {
+      snprintf(line, GCODE_LINE_SIZE, "G0 X%.2f Y%.2f", millimeters(x), millimeters(y));
+    }
+    sendLine(line);
+  } else if(block.type == BLOCK_RELAY){
+    if(block.target == POWER_MAGNET){
+      magnet = block.dirX;
+      sendLine(magnet ? "M3 S1000" : "M5");
+    }
+  } else if(block.type == BLOCK_END){
+    // the dwell is acknowledged only when the movements before it are over
+    sendLine("G4 P0");
+    while(numPending > 0 && readResponse());
+  }
+};
+
+int GcodeStreamer::takeLines(){
+  int taken = lines;
+
+  lines = 0;
+  return taken;
+};
+
+void GcodeStreamer::sendLine(const char * line){
+  int length = strlen(line) + 1;
+
+  // the line is sent only when the receive buffer of the controller has room for it
+  while(numPending == MAX_PENDING_LINES || (numPending > 0 && buffered + length > RX_BUFFER_SIZE)){
+    if(!readResponse()){
+      return;
+    }
+  }
+  if(write(fd, line, length - 1) != length - 1 || write(fd, "\n", 1) != 1){
+    return;
+  }
+  pending[(firstPending + numPending) % MAX_PENDING_LINES] = length;
+  numPending++;
+  buffered += length;
+  lines++;
+};
+
+bool GcodeStreamer::readResponse(){
+  char response[GCODE_LINE_SIZE];
+  int length = 0;
+  char c;
+
+  while(true){
+    if(read(fd, &c, 1) != 1){
+      // the controller has been disconnected: nothing will be acknowledged anymore
+      ::close(fd);
+      fd = -1;
+      numPending = 0;
+      buffered = 0;
+      return false;
+    }
+    if(c == '\n'){
+      break;
+    }
+    if(c != '\r' && length < GCODE_LINE_SIZE - 1){
+      response[length++] = c;
+    }
+  }
+  response[length] = '\0';
+
+  if(strcmp(response, "ok") == 0 || strncmp(response, "error", 5) == 0){
+    if(response[0] == 'e'){
+      printf("\nG-code %s\n", response);
+    }
+    if(numPending > 0){
+      buffered -= pending[firstPending];
+      firstPending = (firstPending + 1) % MAX_PENDING_LINES;
+      numPending--;
+    }
+  }
+  return true;
+};
+
+double GcodeStreamer::millimeters(long steps){
+  return (double) steps * CELL_SIZE / STEPS;
+};
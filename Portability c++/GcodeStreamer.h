@@ -0,0 +1,135 @@
+/*
+ * Header file for the GcodeStreamer class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GCODESTREAMER_H
+#define GCODESTREAMER_H
+
+#include "Block.h"
+#include "Config.h"
+
+// Size of the serial receive buffer of a GRBL controller (bytes)
+#define RX_BUFFER_SIZE 128
+
+// Longest line of G-code sent (or response received)
+#define GCODE_LINE_SIZE 64
+
+// Lines sent and not yet acknowledged (at least 3 bytes each, so the receive buffer cannot hold more)
+#define MAX_PENDING_LINES (RX_BUFFER_SIZE / 3)
+
+class GcodeStreamer {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with no controller connected
+         */
+        GcodeStreamer();
+
+        /**
+         * Connect to a GRBL controller (a serial port or a pty) and set the units, the absolute coordinates
+         * and the position of the solenoid
+         *
+         * - Parameters :
+         *      - device : the path of the serial device
+         *      - x      : the position of the solenoid along the X axis (steps)
+         *      - y      : the position of the solenoid along the Y axis (steps)
+         *
+         * - Return : false if the device cannot be opened
+         */
+        bool open(const char * device, long x, long y);
+
+        /**
+         * Verify if the blocks are streamed to a controller
+         *
+         * - Return : true if a controller is connected
+         */
+        bool isOpen();
+
+        /**
+         * Convert a block into G-code and stream it:
+         *  - BLOCK_MOVE  : G1 at the feed rate of STEP_DELAY with the electromagnet switched on, G0 otherwise
+         *  - BLOCK_RELAY : M3 (on) and M5 (off) for the electromagnet, the controller is always powered so the
+         *                  relay of the CNC board is ignored
+         *  - BLOCK_WAIT  : ignored, the controller itself waits for the end of the movements
+         *  - BLOCK_END   : G4 P0, then the end of any movement is waited
+         *
+         * - Parameters :
+         *      - block : the block to stream
+         */
+        void send(Block block);
+
+        /**
+         * Get the number of lines streamed since the last call
+         *
+         * - Return : the number of lines
+         */
+        int takeLines();
+
+    private:
+        /**
+         * Send a line, waiting for the controller to acknowledge the previous ones until the receive buffer
+         * has room for it (character counting flow control)
+         *
+         * - Parameters :
+         *      - line : the line without the terminator
+         */
+        void sendLine(const char * line);
+
+        /**
+         * Read the next response of the controller: "ok" and "error" acknowledge the oldest pending line, any
+         * other message (es: the welcome message) is ignored
+         *
+         * - Return : false if the controller has been disconnected
+         */
+        bool readResponse();
+
+        /**
+         * Convert a position from steps to mm
+         *
+         * - Parameters :
+         *      - steps : the position (steps)
+         *
+         * - Return : the position (mm)
+         */
+        double millimeters(long steps);
+
+        /**
+         * Private variables
+         *
+         * fd           : the file descriptor of the serial device, -1 if no controller is connected
+         * pending      : the lengths (with the terminator) of the lines not yet acknowledged, oldest first
+         * firstPending : the place of the oldest pending line
+         * numPending   : the number of pending lines
+         * buffered     : the bytes of the pending lines, that are in the receive buffer of the controller
+         * x            : the position of the solenoid along the X axis at the end of the streamed lines (steps)
+         * y            : the position of the solenoid along the Y axis at the end of the streamed lines (steps)
+         * magnet       : indicates if the electromagnet is switched on
+         * lines        : the lines streamed since the last takeLines
+         */
+        int fd;
+        int pending[MAX_PENDING_LINES];
+        int firstPending;
+        int numPending;
+        int buffered;
+        long x;
+        long y;
+        bool magnet;
+        int lines;
+};
+
+#endif
@@ -30,6 +30,11 @@ using namespace std;
 KingsManager::KingsManager(): Manager() {
   kings[WHITE][0] = King::King("E1");
   kings[BLACK][0] = King::King("E8");
+
+  for(int i = 0; i < 2; i++){
+    castling[i][0] = true;
+    castling[i][1] = true;
+  }
 };
 
 // checkCandidates implementation
@@ -71,8 +76,8 @@ char * KingsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
 
     // check the king is alive
     if(kings[turn][0].getAlive()){
-      // check if path is licit
-      if(checkPathIsFree(cbState, vDiff, hDiff, row, col)){
+      // check if path is licit (a step in any direction or a castling)
+      if(checkPathIsFree(cbState, vDiff, hDiff, row, col) || (vDiff == 0 && abs(hDiff) == 2 && checkCastling(cbState, turn, hDiff))){
         if(cbState[row][col]->getBusy()){
           // set a memo to remember that the opponent piece in the destination cell must be removed
           cbState[row][col]->setColor('D');
@@ -120,8 +125,91 @@ void KingsManager::setNewPosition(bool turn, const char * from, const char * des
 };
 
 void KingsManager::findAndRemove(bool turn, const char * destination){
-  if(strcmp(kings[turn][0].getPosition(),destination) == 0){
-      kings[turn][0].setAlive();
-      kings[turn][0].setPosition("Z9");
+  if(strcmp(kings[!turn][0].getPosition(),destination) == 0){
+      kings[!turn][0].setAlive();
+      kings[!turn][0].setPosition("Z9");
+  }
+};
+
+void KingsManager::updateCastling(const char * from, const char * destination){
+  for(int i = 0; i < 2; i++){
+    // the 1 row for the white, the 8 row for the black
+    char initialRow = i == WHITE ? '1' : '8';
+    const char * cells[2] = {from, destination};
+
+    for(int j = 0; j < 2; j++){
+      if(cells[j][1] != initialRow){
+        continue;
+      }
+      if(cells[j][0] == 'E'){
+        castling[i][0] = false;
+        castling[i][1] = false;
+      } else if(cells[j][0] == 'A'){
+        castling[i][0] = false;
+      } else if(cells[j][0] == 'H'){
+        castling[i][1] = false;
+      }
+    }
+  }
+};
+
+bool KingsManager::checkCastling(Cell * cbState[][8], bool turn, int hDiff){
+  // the king is in the E column, the rook in the A (hDiff < 0) or in the H column (hDiff > 0)
+  int side = hDiff > 0 ? 1 : 0;
+  int col = turn ? 7 : 0;
+  int rookRow = hDiff > 0 ? 7 : 0;
+  int step = hDiff > 0 ? 1 : -1;
+
+  if(!castling[turn][side]){
+    return false;
+  }
+
+  // the cells between the king and the rook must be empty
+  for(int row = 4 + step; row != rookRow; row += step){
+    if(cbState[row][col]->getBusy()){
+      return false;
+    }
+  }
+
+  // the king cannot castle out of, through or into check
+  for(int row = 4; row != 4 + 3 * step; row += step){
+    if(moveGenerator.isAttacked(cbState, !turn, row, col)){
+      return false;
+    }
+  }
+
+  return true;
+};
+
+// SetUp implementation
+bool KingsManager::setUp(bool turn, char positions[][3], int count){
+  if(count > 1){
+    return false;
+  }
+
+  for(int i = 0; i < 1; i++){
+    if(i < count){
+      kings[turn][i] = King(positions[i]);
+    } else if(kings[turn][i].getAlive()){
+      kings[turn][i].setAlive();
+    }
+  }
+  return true;
+};
+
+// SetCastling implementation
+void KingsManager::setCastling(Cell * cbState[][8], const char * rights){
+  // FEN letters of the sides: queen side (A rook) and king side (H rook), uppercase for the white player
+  const char letters[2][2] = {{'Q', 'K'}, {'q', 'k'}};
+
+  for(int player = WHITE; player <= BLACK; player++){
+    int col = player == WHITE ? 0 : 7;
+    char color = player == WHITE ? 'W' : 'B';
+    bool kingInPlace = cbState[4][col]->getColor() == color && cbState[4][col]->getPiece() == 'K';
+    for(int side = 0; side < 2; side++){
+      int row = side == 0 ? 0 : 7;
+      castling[player][side] = kingInPlace && strchr(rights, letters[player][side]) != NULL &&
+                               cbState[row][col]->getColor() == color && cbState[row][col]->getPiece() == 'R';
+    }
   }
 };
@@ -66,7 +66,7 @@ char * KnightsManager::checkCandidates(Cell * cbState[][8], bool turn, const cha
           hDiff = destination[0] - knights[turn][i].getPosition()[0];
         } else{               // ambiguous cases --> from ≠ NULL
           // control if actually a knight of the player occupy the position expressed by the variable from 
-          if(checkSource(cbState, turn, from, 'H')){
+          if(!checkSource(cbState, turn, from, 'H')){
             return NULL;
           }
           // calculate the vertical difference yd - yf
@@ -90,7 +90,7 @@ char * KnightsManager::checkCandidates(Cell * cbState[][8], bool turn, const cha
 
             setNewPosition(turn, from, destination);
             candidate = new char[3];
-              for(int i = 0; i<strlen(from);i++){
+              for(int i = 0; i<=strlen(from);i++){
                   candidate[i] = from[i];
               }
               return candidate;
@@ -152,11 +152,39 @@ void KnightsManager::toString(){
 
 void KnightsManager::findAndRemove(bool turn, const char * destination){
   for(int i = 0; i < 2; i++){
-    if(strcmp(knights[turn][i].getPosition(),destination) == 0){
-      knights[turn][i].setAlive();
-      knights[turn][i].setPosition("Z9");
+    if(strcmp(knights[!turn][i].getPosition(),destination) == 0){
+      knights[!turn][i].setAlive();
+      knights[!turn][i].setPosition("Z9");
 
       return;
     }
   }
 };
+
+bool KnightsManager::revive(bool turn, const char * destination){
+  for(int i = 0; i < 2; i++){
+    if(!knights[turn][i].getAlive()){
+      knights[turn][i].setAlive();
+      knights[turn][i].setPosition(destination);
+
+      return true;
+    }
+  }
+  return false;
+};
+
+// SetUp implementation
+bool KnightsManager::setUp(bool turn, char positions[][3], int count){
+  if(count > 2){
+    return false;
+  }
+
+  for(int i = 0; i < 2; i++){
+    if(i < count){
+      knights[turn][i] = Knight(positions[i]);
+    } else if(knights[turn][i].getAlive()){
+      knights[turn][i].setAlive();
+    }
+  }
+  return true;
+};
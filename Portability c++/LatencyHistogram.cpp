@@ -0,0 +1,95 @@
+/*
+ * LatencyHistogram class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+/*
+ * The latencies lower than LATENCY_SUB_BUCKETS us have a bucket each. The other ones are split by their highest
+ * bit (the power of two) and by the 3 following bits, so any power of two has LATENCY_SUB_BUCKETS buckets:
+ *  8 us -> bucket 8, ..., 15 us -> bucket 15, 16-17 us -> bucket 16, ..., 30-31 us -> bucket 23, 32-35 us -> bucket 24
+ */
+
+// Constructor
+LatencyHistogram::LatencyHistogram(){
+  for(int i = 0; i < LATENCY_BUCKETS; i++){
+    buckets[i] = 0;
+  }
+  count = 0;
+  max = 0;
+};
+
+void LatencyHistogram::add(unsigned long long latency){
+  buckets[bucket(latency)]++;
+  count++;
+  if(latency > max){
+    max = latency;
+  }
+};
+
+unsigned long LatencyHistogram::getCount(){
+  return count;
+};
+
+unsigned long long LatencyHistogram::getPercentile(double percentile){
+  // the rank of the percentile among the counted latencies (the first one is 1)
+  unsigned long rank = (unsigned long) (percentile / 100.0 * count + 0.5);
+  unsigned long seen = 0;
+
+  if(count == 0){
+    return 0;
+  }
+  if(rank < 1){
+    rank = 1;
+  }
+  for(int i = 0; i < LATENCY_BUCKETS; i++){
+    seen += buckets[i];
+    if(seen >= rank){
+      unsigned long long limit = upperLimit(i);
+      return limit < max ? limit : max;
+    }
+  }
+  return max;
+};
+
+unsigned long long LatencyHistogram::getMax(){
+  return max;
+};
+
+int LatencyHistogram::bucket(unsigned long long latency){
+  if(latency < LATENCY_SUB_BUCKETS){
+    return (int) latency;
+  }
+  // the power of two of the latency, starting from the one of LATENCY_SUB_BUCKETS
+  int power = 0;
+  while((latency >> power) >= 2 * LATENCY_SUB_BUCKETS){
+    power++;
+  }
+  int index = LATENCY_SUB_BUCKETS * (power + 1) + (int) ((latency >> power) - LATENCY_SUB_BUCKETS);
+  return index < LATENCY_BUCKETS ? index : LATENCY_BUCKETS - 1;
+};
+
+unsigned long long LatencyHistogram::upperLimit(int index){
+  if(index < LATENCY_SUB_BUCKETS){
+    return index;
+  }
+  int power = index / LATENCY_SUB_BUCKETS - 1;
+  unsigned long long first = (unsigned long long) (LATENCY_SUB_BUCKETS + index % LATENCY_SUB_BUCKETS) << power;
+  return first + (1ULL << power) - 1;
+};
@@ -0,0 +1,106 @@
+/*
+ * Header file for the LatencyHistogram class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+// Buckets of any power of two: the latencies are kept with an error smaller than 1 / LATENCY_SUB_BUCKETS
+#define LATENCY_SUB_BUCKETS 8
+
+// Number of buckets, enough for latencies up to 2^36 us (about 19 hours)
+#define LATENCY_BUCKETS (LATENCY_SUB_BUCKETS * 34)
+
+class LatencyHistogram {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with no latency
+         */
+        LatencyHistogram();
+
+        /**
+         * Count a latency in its bucket: the buckets double their width at any power of two, so the histogram
+         * keeps the same relative precision from the microseconds of the parser to the seconds of the motion
+         * without storing the samples
+         *
+         * - Parameters :
+         *      - latency : the latency (us)
+         */
+        void add(unsigned long long latency);
+
+        /**
+         * Get the number of latencies counted
+         *
+         * - Return : the number of latencies
+         */
+        unsigned long getCount();
+
+        /**
+         * Get a percentile of the latencies
+         * N.B.: the result is the upper limit of the bucket that contains the percentile, so it is never lower than
+         *       the exact percentile (the maximum is exact)
+         *
+         * - Parameters :
+         *      - percentile : the percentile, between 0 and 100
+         *
+         * - Return : the latency (us), 0 if no latency has been counted
+         */
+        unsigned long long getPercentile(double percentile);
+
+        /**
+         * Get the largest latency counted
+         *
+         * - Return : the latency (us)
+         */
+        unsigned long long getMax();
+
+    private:
+        /**
+         * Find the bucket of a latency
+         *
+         * - Parameters :
+         *      - latency : the latency (us)
+         *
+         * - Return : the index of the bucket
+         */
+        static int bucket(unsigned long long latency);
+
+        /**
+         * Find the largest latency of a bucket
+         *
+         * - Parameters :
+         *      - index : the index of the bucket
+         *
+         * - Return : the latency (us)
+         */
+        static unsigned long long upperLimit(int index);
+
+        /**
+         * Private variables
+         *
+         * buckets : the number of latencies of any bucket
+         * count   : the number of latencies counted
+         * max     : the largest latency counted
+         */
+        unsigned long buckets[LATENCY_BUCKETS];
+        unsigned long count;
+        unsigned long long max;
+};
+
+#endif
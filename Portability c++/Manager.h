@@ -56,6 +56,19 @@ class Manager {
          */
         virtual void findAndRemove(bool turn, const char * destination) = 0;
 
+        /**
+         * Place the pieces of a player on the cells of a new position (es: RESET or FEN commands): the pieces
+         * exceeding the list are set as dead
+         *
+         * - Parameters :
+         *      - turn      : indicates the white (false) or the black (true) player
+         *      - positions : the coordinates of the cells of the pieces (es: "E1")
+         *      - count     : the number of cells of the list
+         *
+         * - Return : a boolean value indicating if the player has enough pieces of the type
+         */
+        virtual bool setUp(bool turn, char positions[][3], int count) = 0;
+
         /**
          * Set to dead the piece in the position expressed by the parameter
          * 
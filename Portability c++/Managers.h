@@ -20,6 +20,7 @@
 #define MANAGERS_H
 
 #include "Manager.h"
+#include "MoveGenerator.h"
 #include "Pieces.h"
 
 class BishopsManager: public Manager{
@@ -58,6 +59,29 @@ class BishopsManager: public Manager{
          */
         void findAndRemove(bool turn, const char * destination);
 
+        /**
+         * Place the bishops of a player on the cells of a new position, the ones exceeding the list are set as dead
+         *
+         * - Parameters :
+         *      - turn      : indicates the white (false) or the black (true) player
+         *      - positions : the coordinates of the cells of the bishops
+         *      - count     : the number of cells of the list
+         *
+         * - Return : a boolean value indicating if the player has enough bishops
+         */
+        bool setUp(bool turn, char positions[][3], int count);
+
+        /**
+         * Bring back to the chessboard a captured bishop (es: when a pawn is promoted)
+         *
+         * - Parameters :
+         *      - turn        : indicates if move the white (false) or the black (true)
+         *      - destination : the coordinates of the cell where the bishop is placed
+         *
+         * - Return : a boolean value indicating if a captured bishop of the player has been found
+         */
+        bool revive(bool turn, const char * destination);
+
         /**
          * Show a string representation of the object
          *
@@ -121,7 +145,8 @@ class KingsManager: public Manager{
          *      - destination : indicates the destination cell of the piece that the player wants to move
          *
          * - Return : a char pointer pointing to the coordinates of the king on which the move could be performed.
-         *            N.B.: The function return NULL if the king cannot be moved to the destination required
+         *            N.B.: The function return NULL if the king cannot be moved to the destination required.
+         *                  A move of two cells along the row is a castling (the rook is moved by the ChessBoard)
          */
         char * checkCandidates(Cell * cbState[][8], bool turn, const char * from, const char * destination);
 
@@ -134,6 +159,38 @@ class KingsManager: public Manager{
          */
         void findAndRemove(bool turn, const char * destination);
 
+        /**
+         * Place the king of a player on the cell of a new position, it is set as dead if the list is empty
+         *
+         * - Parameters :
+         *      - turn      : indicates the white (false) or the black (true) player
+         *      - positions : the coordinates of the cell of the king
+         *      - count     : the number of cells of the list (0 or 1)
+         *
+         * - Return : false if the list has more than one cell
+         */
+        bool setUp(bool turn, char positions[][3], int count);
+
+        /**
+         * Update the castling rights after a move: a player loses them when its king leaves the initial cell
+         * and loses the right on a side when the rook of that side leaves (or is captured in) its initial cell
+         *
+         * - Parameters :
+         *      - from        : the coordinates of the source cell of the move
+         *      - destination : the coordinates of the destination cell of the move
+         */
+        void updateCastling(const char * from, const char * destination);
+
+        /**
+         * Set the castling rights of a new position: a right is kept only if the king and the rook of that
+         * side are on their initial cells
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - rights  : the castling field of a FEN string (es: "KQkq", "-" if no castling is available)
+         */
+        void setCastling(Cell * cbState[][8], const char * rights);
+
         /**
          * Show a string representation of the object
          *
@@ -167,14 +224,33 @@ class KingsManager: public Manager{
          */
         void setNewPosition(bool turn, const char * from, const char * destination);
 
+        /**
+         * Verify if the king can castle: the player has the right on that side, the cells between the king
+         * and the rook are empty and the cells crossed by the king (source and destination included) are
+         * not attacked by the opponent
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - turn    : indicates if move the white (false) or the black (true)
+         *      - hDiff   : indicates how many horizontal steps there are from source to destination (+2 or -2)
+         *
+         * - Return : a bool value indicating if the castling can be performed (true) or not (false)
+         */
+        bool checkCastling(Cell * cbState[][8], bool turn, int hDiff);
+
         /**
          * Private variables
          *
-         * kings : represents the list of pawns.
-         *         Note: the first row refers to the white pawns, while the second
-         *         row refers to the black ones
+         * kings         : represents the list of pawns.
+         *                 Note: the first row refers to the white pawns, while the second
+         *                 row refers to the black ones
+         * castling      : keep track of the castling rights of any player, on the side of the A rook (0)
+         *                 and on the side of the H rook (1)
+         * moveGenerator : verify if the cells crossed by the king while castling are attacked
          */
         King kings [2][1];
+        bool castling[2][2];
+        MoveGenerator moveGenerator;
 };
 
 class KnightsManager: public Manager{
@@ -213,6 +289,29 @@ class KnightsManager: public Manager{
          */
         void findAndRemove(bool turn, const char * destination);
 
+        /**
+         * Place the knights of a player on the cells of a new position, the ones exceeding the list are set as dead
+         *
+         * - Parameters :
+         *      - turn      : indicates the white (false) or the black (true) player
+         *      - positions : the coordinates of the cells of the knights
+         *      - count     : the number of cells of the list
+         *
+         * - Return : a boolean value indicating if the player has enough knights
+         */
+        bool setUp(bool turn, char positions[][3], int count);
+
+        /**
+         * Bring back to the chessboard a captured knight (es: when a pawn is promoted)
+         *
+         * - Parameters :
+         *      - turn        : indicates if move the white (false) or the black (true)
+         *      - destination : the coordinates of the cell where the knight is placed
+         *
+         * - Return : a boolean value indicating if a captured knight of the player has been found
+         */
+        bool revive(bool turn, const char * destination);
+
         /**
          * Show a string representation of the object
          *
@@ -289,6 +388,29 @@ class QueensManager: public Manager{
          */
         void findAndRemove(bool turn, const char * destination);
 
+        /**
+         * Place the queen of a player on the cell of a new position, it is set as dead if the list is empty
+         *
+         * - Parameters :
+         *      - turn      : indicates the white (false) or the black (true) player
+         *      - positions : the coordinates of the cell of the queen
+         *      - count     : the number of cells of the list (0 or 1)
+         *
+         * - Return : false if the list has more than one cell
+         */
+        bool setUp(bool turn, char positions[][3], int count);
+
+        /**
+         * Bring back to the chessboard a captured queen (es: when a pawn is promoted)
+         *
+         * - Parameters :
+         *      - turn        : indicates if move the white (false) or the black (true)
+         *      - destination : the coordinates of the cell where the queen is placed
+         *
+         * - Return : a boolean value indicating if a captured queen of the player has been found
+         */
+        bool revive(bool turn, const char * destination);
+
         /**
          * Show a string representation of the object
          *
@@ -392,6 +514,57 @@ class PawnsManager: public Manager{
          */
         void findAndRemove(bool turn, const char * destination);
 
+        /**
+         * Place the pawns of a player on the cells of a new position, the ones exceeding the list are set as dead
+         *
+         * - Parameters :
+         *      - turn      : indicates the white (false) or the black (true) player
+         *      - positions : the coordinates of the cells of the pawns
+         *      - count     : the number of cells of the list
+         *
+         * - Return : a boolean value indicating if the player has enough pawns
+         */
+        bool setUp(bool turn, char positions[][3], int count);
+
+        /**
+         * Promote the pawn in a cell to another type of piece, keeping it on the chessboard
+         *
+         * - Parameters :
+         *      - turn      : indicates if move the white (false) or the black (true)
+         *      - position  : the coordinates of the cell of the pawn
+         *      - promoType : the type of the new piece ("TORRE", "ALFIERE", "CAVALLO" or "REGINA")
+         */
+        void promote(bool turn, const char * position, const char * promoType);
+
+        /**
+         * Get the pawn that a player can capture en passant, because it has just performed a 2 steps first move
+         *
+         * - Parameters :
+         *      - turn : indicates the player that captures: the white (false) or the black (true)
+         *
+         * - Return : the coordinates of the cell of the pawn that can be captured, NULL if there is none
+         */
+        const char * getEnPassant(bool turn);
+
+        /**
+         * Forbid the en passant of a player, that has not used it in its move
+         *
+         * - Parameters :
+         *      - turn : indicates the player: the white (false) or the black (true)
+         */
+        void clearEnPassant(bool turn);
+
+        /**
+         * Move a pawn that captures en passant to the cell behind the captured pawn (the captured pawn is removed
+         * by findAndRemove)
+         *
+         * - Parameters :
+         *      - turn        : indicates if move the white (false) or the black (true)
+         *      - from        : the coordinates of the cell of the pawn
+         *      - destination : the coordinates of the cell behind the captured pawn
+         */
+        void enPassant(bool turn, const char * from, const char * destination);
+
         /**
          * Show a string representation of the object
          *
@@ -505,6 +678,39 @@ class RooksManager: public Manager{
          */
         void findAndRemove(bool turn, const char * destination);
 
+        /**
+         * Place the rooks of a player on the cells of a new position, the ones exceeding the list are set as dead
+         *
+         * - Parameters :
+         *      - turn      : indicates the white (false) or the black (true) player
+         *      - positions : the coordinates of the cells of the rooks
+         *      - count     : the number of cells of the list
+         *
+         * - Return : a boolean value indicating if the player has enough rooks
+         */
+        bool setUp(bool turn, char positions[][3], int count);
+
+        /**
+         * Bring back to the chessboard a captured rook (es: when a pawn is promoted)
+         *
+         * - Parameters :
+         *      - turn        : indicates if move the white (false) or the black (true)
+         *      - destination : the coordinates of the cell where the rook is placed
+         *
+         * - Return : a boolean value indicating if a captured rook of the player has been found
+         */
+        bool revive(bool turn, const char * destination);
+
+        /**
+         * Move the rook involved in a castling (the king has already been validated by the KingsManager)
+         *
+         * - Parameters :
+         *      - turn        : indicates if move the white (false) or the black (true)
+         *      - from        : the coordinates of the initial cell of the rook
+         *      - destination : the coordinates of the cell next to the king where the rook is placed
+         */
+        void castle(bool turn, const char * from, const char * destination);
+
         /**
          * Show a string representation of the object
          *
@@ -0,0 +1,86 @@
+/*
+ * MotionEstimator class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MotionEstimator.h"
+#include <stdlib.h>
+
+using namespace std;
+
+// Estimate implementation (the time is counted in us, as the simulator clock)
+long MotionEstimator::estimate(long x, long y, bool powered, Motion motions[], int numMotions){
+  long time = 0;
+  bool magnet = false;
+
+  for(int i = 0; i < numMotions; i++){
+    long deltaX = labs(motions[i].x - x);
+    long deltaY = labs(motions[i].y - y);
+
+    // the direct function does not power up the CNC board if the solenoid is already in position
+    if(!powered && (motions[i].carry || deltaX > 0 || deltaY > 0)){
+      time += (RELAY_DELAY + POWER_UP_DELAY) * 1000L;
+      powered = true;
+    }
+    // the electromagnet is switched on at the start of a carry and off at its end
+    if(motions[i].carry != magnet){
+      time += RELAY_DELAY * 1000L;
+      magnet = motions[i].carry;
+    }
+
+    if(motions[i].carry){
+      // a segment of a route is a diagonal or a movement along an axis
+      if(deltaX == deltaY){
+        time += movementTime(deltaX);
+      } else {
+        time += movementTime(deltaX) + movementTime(deltaY);
+      }
+    } else {
+      time += directMicros(x, y, motions[i].x, motions[i].y);
+    }
+    x = motions[i].x;
+    y = motions[i].y;
+  }
+
+  if(magnet){
+    time += RELAY_DELAY * 1000L;
+  }
+  // the CNC board is powered off at the end of the sequence
+  if(powered){
+    time += (FINISH_DELAY + RELAY_DELAY) * 1000L;
+  }
+  return time / 1000;
+};
+
+long MotionEstimator::directTime(long fromX, long fromY, long toX, long toY){
+  return directMicros(fromX, fromY, toX, toY) / 1000;
+};
+
+long MotionEstimator::movementTime(long steps){
+  if(steps == 0){
+    return 0;
+  }
+  return DIR_DELAY * 1000L + 2L * STEP_DELAY * steps;
+};
+
+long MotionEstimator::directMicros(long fromX, long fromY, long toX, long toY){
+  long deltaX = labs(toX - fromX);
+  long deltaY = labs(toY - fromY);
+  long diagonal = deltaX < deltaY ? deltaX : deltaY;
+
+  // the diagonal movement and then the movement along the remaining axis (only one of the two is not empty)
+  return movementTime(diagonal) + movementTime(deltaX - diagonal) + movementTime(deltaY - diagonal);
+};
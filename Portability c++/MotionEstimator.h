@@ -0,0 +1,96 @@
+/*
+ * Header file for the MotionEstimator class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOTIONESTIMATOR_H
+#define MOTIONESTIMATOR_H
+
+#include "Config.h"
+
+// Maximum number of motions of a sequence (es: a promotion with capture is made by three carries)
+#define MAX_MOTIONS 64
+
+/**
+ * Motion variables
+ *
+ * x     : the position reached along the X axis, expressed in steps from the center of the A1 cell
+ * y     : the position reached along the Y axis, expressed in steps from the center of the A1 cell
+ * carry : true if the electromagnet carries a piece along a straight segment of a route, false if the
+ *         solenoid travels alone (diagonal first and then along an axis, as the direct function)
+ */
+struct Motion {
+    int x;
+    int y;
+    bool carry;
+};
+
+class MotionEstimator {
+    public:
+        /**
+         * Estimate the duration of a motion sequence without performing it, following the same timing of the
+         * ChessBoard: DIR_DELAY and then the steps (2 * STEP_DELAY each) for any movement of the stepper motors,
+         * the power up of the CNC board before the first movement, RELAY_DELAY when the electromagnet is
+         * switched on or off between the carries and the power down at the end of the sequence.
+         * N.B.: the stepper motors run at the constant rate of STEP_DELAY (there is no acceleration ramp), so the
+         *       time spent to start a movement is the DIR_DELAY
+         *
+         * - Parameters :
+         *      - x          : the position of the solenoid along the X axis before the sequence (steps)
+         *      - y          : the position of the solenoid along the Y axis before the sequence (steps)
+         *      - powered    : indicates if the CNC board is already powered before the sequence
+         *      - motions    : the list of the motions of the sequence
+         *      - numMotions : the number of motions of the sequence
+         *
+         * - Return : the duration of the sequence (ms)
+         */
+        static long estimate(long x, long y, bool powered, Motion motions[], int numMotions);
+
+        /**
+         * Estimate the time needed by the solenoid to go directly from a point to another one: a diagonal
+         * movement and then a movement along an axis (the same as the direct function of the ChessBoard)
+         *
+         * - Parameters :
+         *      - fromX : the position of the start point along the X axis (steps)
+         *      - fromY : the position of the start point along the Y axis (steps)
+         *      - toX   : the position of the end point along the X axis (steps)
+         *      - toY   : the position of the end point along the Y axis (steps)
+         *
+         * - Return : the travel time (ms)
+         */
+        static long directTime(long fromX, long fromY, long toX, long toY);
+
+        /**
+         * Time needed by a single movement of the stepper motors (along an axis or along the diagonal)
+         *
+         * - Parameters :
+         *      - steps : the number of steps of the movement
+         *
+         * - Return : the duration of the movement (us), 0 if there are no steps
+         */
+        static long movementTime(long steps);
+
+    private:
+
+        /**
+         * Time needed by a travel without the electromagnet, in the same way of directTime
+         *
+         * - Return : the duration of the travel (us)
+         */
+        static long directMicros(long fromX, long fromY, long toX, long toY);
+};
+
+#endif
@@ -0,0 +1,334 @@
+/*
+ * MotionPipeline class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MotionPipeline.h"
+#include <stdio.h>
+#ifndef ARDUINO
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+#ifndef ARDUINO
+MotionPipeline * MotionPipeline::pipelines[MAX_PIPELINES];
+volatile int MotionPipeline::numPipelines = 0;
+pthread_t MotionPipeline::worker;
+#endif
+
+// Constructor
+MotionPipeline::MotionPipeline(){
+  head = 0;
+  tail = 0;
+  busy = false;
+  blockStart = 0;
+  remaining = 0;
+  outputs = 0;
+  sequenceStarted = false;
+  startTime = 0;
+  lastDuration = 0;
+  lastEstimate = -1;
+  started = false;
+#ifndef ARDUINO
+  wallStart = 0;
+  starvedSince = 0;
+  starvedAt = 0;
+  shared = false;
+#endif
+};
+
+void MotionPipeline::push(Block block){
+  // the pipeline is executed from the first block, when its owner is in its final place
+  if(!started){
+    start();
+  }
+
+  // the pipeline is full: wait for the consumer to free a place
+  while((head + 1) % PIPELINE_SIZE == tail){
+    pause();
+  }
+  blocks[head] = block;
+  // the block must be written before it is published to the consumer
+  __sync_synchronize();
+  head = (head + 1) % PIPELINE_SIZE;
+};
+
+bool MotionPipeline::idle(){
+  return head == tail && !busy && scheduler.idle();
+};
+
+void MotionPipeline::pause(){
+#ifdef ARDUINO
+  service();
+#else
+  if(!shared){
+    service();
+  }
+  usleep(100);
+#endif
+};
+
+bool MotionPipeline::service(){
+  if(!busy){
+    if(!pop(&current)){
+#ifndef ARDUINO
+      // the producer is late: the timer goes on executing the edges in the ring
+      starve();
+#endif
+      return false;
+    }
+#ifndef ARDUINO
+    // the time waited for the block is spent before its first edge
+    if(starvedSince > 0){
+      starve();
+      starvedSince = 0;
+    }
+#endif
+    load(current);
+  }
+
+#ifndef ARDUINO
+  // an external controller moves the pieces: the block is streamed as G-code and no step is generated here
+  if(streamer.isOpen()){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    unsigned long wallTime = now.tv_sec * 1000UL + now.tv_nsec / 1000000;
+    if(current.type != BLOCK_END && wallStart == 0){
+      wallStart = wallTime;
+    }
+    streamer.send(current);
+    remaining = 0;
+    if(current.type == BLOCK_END){
+      // the controller acknowledges the end of the sequence when the pieces are in place
+      clock_gettime(CLOCK_MONOTONIC, &now);
+      wallTime = now.tv_sec * 1000UL + now.tv_nsec / 1000000;
+      finishSequence(current);
+      printf("\n%s sequence : ", current.name);
+      if(current.count >= 0){
+        printf("estimated %ld ms, ", current.count);
+      }
+      printf("streamed %d lines in %lu ms\n", streamer.takeLines(), wallStart > 0 ? wallTime - wallStart : 0);
+      fflush(stdout);
+      wallStart = 0;
+    }
+    busy = false;
+    return true;
+  }
+#endif
+
+  // the edges are precomputed while there is room, the timer interrupt consumes them at its own pace
+  while(remaining > 0 && !scheduler.full()){
+    scheduler.push(nextEdge());
+#ifndef ARDUINO
+    // the simulated timer consumes an edge whenever the ring is full, as the interrupt does while the loop of the
+    // sketch refills the ring, so the ring runs empty only if the blocks arrive late
+    if(scheduler.full()){
+      timer.fire(&scheduler, &simulator);
+    }
+#endif
+  }
+#ifndef ARDUINO
+  // the last edges of the sequence are executed right away
+  if(current.type == BLOCK_END){
+    while(timer.fire(&scheduler, &simulator));
+  }
+#endif
+
+  if(remaining > 0){
+    return true;
+  }
+  if(current.type == BLOCK_END){
+    // the sequence ends when its last edge has been executed
+    if(!scheduler.idle()){
+      return true;
+    }
+    finishSequence(current);
+    printf("\n%s sequence : ", current.name);
+    if(current.count >= 0){
+      printf("estimated %ld ms, ", current.count);
+    }
+    printf("executed %lu ms", lastDuration);
+#ifndef ARDUINO
+    printf(", step jitter %lu us, %d underruns", timer.getJitter(), timer.getUnderruns());
+    timer.reset();
+#endif
+    printf("\n");
+    fflush(stdout);
+  }
+
+#ifndef ARDUINO
+  // the block has been executed, so its time is known
+  if(trace.isOpen()){
+    TraceRecord record;
+    record.block = current;
+    record.outputs = outputs;
+    record.start = blockStart;
+    record.duration = simulator.micros() - blockStart;
+    trace.append(record);
+  }
+#endif
+
+  busy = false;
+  return true;
+};
+
+unsigned long MotionPipeline::interrupt(){
+  return scheduler.interrupt();
+};
+
+#ifndef ARDUINO
+bool MotionPipeline::openTrace(const char * path){
+  return trace.open(path);
+};
+
+bool MotionPipeline::openController(const char * device, long x, long y){
+  return streamer.open(device, x, y);
+};
+#endif
+
+unsigned long MotionPipeline::getLastDuration(){
+  return lastDuration;
+};
+
+void MotionPipeline::start(){
+  started = true;
+#ifndef ARDUINO
+  // only the chessboards (all in the main thread) start a pipeline, so the list has a single writer
+  if(numPipelines == MAX_PIPELINES){
+    printf("\nToo many pipelines: the blocks are executed while waiting for them\n");
+    return;
+  }
+  shared = true;
+  pipelines[numPipelines] = this;
+  // the pipeline must be in the list before the shared thread counts it
+  __sync_synchronize();
+  numPipelines++;
+  if(numPipelines == 1){
+    pthread_create(&worker, NULL, run, NULL);
+  }
+#endif
+  // on the boards the loop of the sketch calls service, the timer interrupt calls interrupt
+};
+
+#ifndef ARDUINO
+void MotionPipeline::starve(){
+  // the ring runs empty only inside a sequence, at its end the timer stops as expected
+  if(!sequenceStarted){
+    return;
+  }
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  unsigned long wallTime = now.tv_sec * 1000000UL + now.tv_nsec / 1000;
+  if(starvedSince == 0){
+    starvedSince = wallTime;
+    starvedAt = simulator.micros();
+  }
+  // the virtual clock follows the real one while the producer is late
+  timer.advance(&scheduler, &simulator, starvedAt + (wallTime - starvedSince));
+};
+
+void * MotionPipeline::run(void *){
+  while(true){
+    // the pipelines are served in turn, the thread rests only when all of them are empty
+    bool working = false;
+    int count = numPipelines;
+    for(int i = 0; i < count; i++){
+      working = pipelines[i]->service() || working;
+    }
+    if(!working){
+      usleep(100);
+    }
+  }
+  return NULL;
+};
+#endif
+
+void MotionPipeline::load(Block block){
+  blockStart = simulator.micros();
+  if(block.type == BLOCK_END){
+    remaining = 0;
+    return;
+  }
+  if(!sequenceStarted){
+    sequenceStarted = true;
+    startTime = simulator.millis();
+  }
+
+  if(block.type == BLOCK_MOVE){
+    // the change of direction and then two edges (high and low) for each step
+    remaining = 1 + 2 * block.count;
+  } else {
+    if(block.type == BLOCK_RELAY){
+      unsigned char relay = block.target == POWER_CNC ? OUT_CNC : OUT_MAGNET;
+      outputs = block.dirX ? outputs | relay : outputs & ~relay;
+      remaining = RELAY_DELAY * 1000L;
+    } else {
+      remaining = block.count * 1000L;
+    }
+  }
+};
+
+Edge MotionPipeline::nextEdge(){
+  Edge edge;
+
+  if(current.type == BLOCK_MOVE){
+    unsigned char steppers = ((current.target & MOVE_X) ? OUT_X_STP : 0) | ((current.target & MOVE_Y) ? OUT_Y_STP : 0);
+
+    if(remaining == 1 + 2 * current.count){
+      // the direction pins of the moved stepper motors are set first
+      if(current.target & MOVE_X){
+        outputs = current.dirX ? outputs | OUT_X_DIR : outputs & ~OUT_X_DIR;
+      }
+      if(current.target & MOVE_Y){
+        outputs = current.dirY ? outputs | OUT_Y_DIR : outputs & ~OUT_Y_DIR;
+      }
+      edge.outputs = outputs;
+      edge.interval = DIR_DELAY * 1000L;
+    } else {
+      // the step pins are raised on the even edges left and lowered on the odd ones
+      edge.outputs = remaining % 2 == 0 ? outputs | steppers : outputs;
+      edge.interval = STEP_DELAY;
+    }
+    remaining--;
+  } else {
+    // a relay or a wait keeps the outputs for its whole time, split in intervals that the timer can count
+    edge.outputs = outputs;
+    edge.interval = remaining > MAX_INTERVAL ? MAX_INTERVAL : remaining;
+    remaining -= edge.interval;
+  }
+  return edge;
+};
+
+bool MotionPipeline::pop(Block * block){
+  if(head == tail){
+    return false;
+  }
+  // the pipeline is not idle from the moment the block leaves it
+  busy = true;
+  *block = blocks[tail];
+  __sync_synchronize();
+  tail = (tail + 1) % PIPELINE_SIZE;
+  return true;
+};
+
+void MotionPipeline::finishSequence(Block block){
+  // a sequence without movements starts and ends now
+  lastDuration = sequenceStarted ? simulator.millis() - startTime : 0;
+  lastEstimate = block.count;
+  sequenceStarted = false;
+};
@@ -0,0 +1,236 @@
+/*
+ * Header file for the MotionPipeline class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOTIONPIPELINE_H
+#define MOTIONPIPELINE_H
+
+#include "Block.h"
+#include "Config.h"
+#include "Simulator.h"
+#include "StepScheduler.h"
+#ifndef ARDUINO
+#include "GcodeStreamer.h"
+#include "MotionTrace.h"
+#include "SimulatedTimer.h"
+#include <pthread.h>
+#endif
+
+// Number of blocks of the pipeline (a move is made by about ten blocks)
+#define PIPELINE_SIZE 32
+
+// Number of pipelines executed by the shared thread on the host (one for each chessboard)
+#define MAX_PIPELINES 24
+
+class MotionPipeline {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with the pipeline empty
+         */
+        MotionPipeline();
+
+        /**
+         * Append a block to the pipeline, waiting for a free place if the pipeline is full. The blocks are
+         * converted in order into the edges of the step scheduler, executed by a timer interrupt, so the
+         * caller can go on (es: reading and validating the next command) while the pieces are moving
+         * N.B.: only one producer (the ChessBoard) can append blocks
+         *
+         * - Parameters :
+         *      - block : the block to append
+         */
+        void push(Block block);
+
+        /**
+         * Verify if all the blocks have been executed: this is the point where the solenoid is still and
+         * a motion outside of the sequences (es: the drift) may begin
+         *
+         * - Return : true if the pipeline is empty and no block is being executed
+         */
+        bool idle();
+
+        /**
+         * Wait a little (without blocking the execution of the blocks) before checking the pipeline again.
+         * On the boards there is no thread, so the blocks are converted into edges in the meanwhile (as on the
+         * host for a pipeline that the shared thread cannot take)
+         */
+        void pause();
+
+        /**
+         * Convert the current block into edges of the step scheduler as long as there is room for them,
+         * taking the next block when the current one is completed. It is called by a thread shared by all the
+         * pipelines on the host, where a simulated timer executes the edges right away, and by the loop of the
+         * sketch on the boards, where it never waits for the timer
+         *
+         * - Return : false if the pipeline is empty
+         */
+        bool service();
+
+        /**
+         * Body of the timer interrupt of the step scheduler (on the boards)
+         *
+         * - Return : the interval (us) programmed in the timer, 0 if the timer has been stopped
+         */
+        unsigned long interrupt();
+
+#ifndef ARDUINO
+        /**
+         * Record any executed block (with its timing and the state of the outputs) in a binary trace file
+         *
+         * - Parameters :
+         *      - path : the path of the trace file, it is overwritten
+         *
+         * - Return : false if the file cannot be created
+         */
+        bool openTrace(const char * path);
+
+        /**
+         * Stream the blocks as G-code to an external GRBL controller instead of generating the steps, so the
+         * timing of the stepper motors is left to the controller
+         *
+         * - Parameters :
+         *      - device : the path of the serial device of the controller
+         *      - x      : the position of the solenoid along the X axis when the first block is streamed (steps)
+         *      - y      : the position of the solenoid along the Y axis when the first block is streamed (steps)
+         *
+         * - Return : false if the device cannot be opened
+         */
+        bool openController(const char * device, long x, long y);
+#endif
+
+        /**
+         * Get the time measured for the last completed sequence
+         *
+         * - Return : the time (ms) between the first block and the end of the sequence
+         */
+        unsigned long getLastDuration();
+
+    private:
+        /**
+         * Start the execution of the blocks: the pipeline joins the shared thread on the host (started by the
+         * first pipeline), the timer interrupt on the boards
+         */
+        void start();
+
+#ifndef ARDUINO
+        /**
+         * Go on executing the edges in the ring while no block is waiting inside a sequence: the virtual clock
+         * follows the real one from the moment the pipeline has been found empty, so the ring runs empty (and the
+         * timer measures an underrun) only if the producer is late for longer than the edges in the ring
+         */
+        void starve();
+
+        /**
+         * Body of the thread that executes the blocks of all the pipelines on the host, in turn, so many
+         * chessboards (es: the sessions of the event loop) do not need a thread each
+         */
+        static void * run(void *);
+#endif
+
+        /**
+         * Prepare the conversion of a block into edges
+         *
+         * - Parameters :
+         *      - block : the block taken from the pipeline
+         */
+        void load(Block block);
+
+        /**
+         * Precompute the next edge of the current block
+         *
+         * - Return : the edge, the outputs keep the levels set by the previous edges
+         */
+        Edge nextEdge();
+
+        /**
+         * Take the next block from the pipeline
+         *
+         * - Parameters :
+         *      - block : filled with the block
+         *
+         * - Return : false if the pipeline is empty
+         */
+        bool pop(Block * block);
+
+        /**
+         * Close a sequence, keeping the time spent since its first block and the estimated one
+         *
+         * - Parameters :
+         *      - block : the BLOCK_END of the sequence
+         */
+        void finishSequence(Block block);
+
+        /**
+         * Private variables
+         *
+         * blocks          : the ring buffer of the blocks
+         * head            : the place of the next appended block (written only by the producer)
+         * tail            : the place of the next executed block (written only by the consumer)
+         * busy            : indicates if a block is being converted or waits for the edges before it (BLOCK_END)
+         * current         : the block being converted into edges
+         * blockStart      : the simulator time (us) of the start of the current block
+         * remaining       : the edges (BLOCK_MOVE) or the time in us (BLOCK_RELAY and BLOCK_WAIT) left to convert
+         * outputs         : the levels of the outputs after the last precomputed edge
+         * scheduler       : the ring buffer of the edges consumed by the timer interrupt
+         * sequenceStarted : indicates if a block of the current sequence has already been executed
+         * startTime       : the simulator time (ms) of the start of the current sequence
+         * lastDuration    : the time (ms) measured by the simulator for the last sequence
+         * lastEstimate    : the estimated time (ms) of the last sequence (-1 if it is not known)
+         * simulator       : the virtual clock advanced by the execution of the blocks
+         * timer           : the timer that executes the edges on the host, measuring the jitter of the steps
+         * trace           : the trace of the executed blocks on the host (not recorded if it is not open)
+         * streamer        : the G-code backend on the host (the steps are generated if it is not open)
+         * wallStart       : the real time (ms) of the start of the current sequence streamed to the controller
+         * starvedSince    : the real time (us) when the pipeline has been found empty inside a sequence (0 if it is not)
+         * starvedAt       : the simulator time (us) when the pipeline has been found empty inside a sequence
+         * started         : indicates if the execution of the blocks has been started
+         * shared          : indicates if the blocks are executed by the shared thread on the host
+         * pipelines       : the pipelines executed by the shared thread
+         * numPipelines    : the number of pipelines executed by the shared thread (it only grows)
+         * worker          : the shared thread, started by the first pipeline
+         */
+        Block blocks[PIPELINE_SIZE];
+        volatile unsigned char head;
+        volatile unsigned char tail;
+        volatile bool busy;
+        Block current;
+        unsigned long blockStart;
+        long remaining;
+        unsigned char outputs;
+        StepScheduler scheduler;
+        bool sequenceStarted;
+        unsigned long startTime;
+        volatile unsigned long lastDuration;
+        volatile long lastEstimate;
+        Simulator simulator;
+        bool started;
+#ifndef ARDUINO
+        SimulatedTimer timer;
+        MotionTrace trace;
+        GcodeStreamer streamer;
+        unsigned long wallStart;
+        unsigned long starvedSince;
+        unsigned long starvedAt;
+        bool shared;
+        static MotionPipeline * pipelines[MAX_PIPELINES];
+        static volatile int numPipelines;
+        static pthread_t worker;
+#endif
+};
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * MotionTrace class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MotionTrace.h"
+#include <string.h>
+
+using namespace std;
+
+/*
+ * Layout of a record (little endian):
+ *  0     : type of the block
+ *  1     : target of the block (the stepper motors or the pin of the relay)
+ *  2     : directions (bit 0 = dirX, bit 1 = dirY)
+ *  3     : outputs at the end of the block
+ *  4-5   : steps (BLOCK_MOVE), time in ms (BLOCK_WAIT) or length of the name (BLOCK_END)
+ *  6-9   : start time (us)
+ *  10-13 : duration (us), the estimated time in ms for a BLOCK_END (0xFFFFFFFF if it is not known)
+ */
+
+// Constructor
+MotionTrace::MotionTrace(){
+  file = NULL;
+};
+
+bool MotionTrace::open(const char * path){
+  file = fopen(path, "wb");
+  if(file == NULL){
+    return false;
+  }
+  fwrite(TRACE_MAGIC, 1, 4, file);
+  return true;
+};
+
+bool MotionTrace::isOpen(){
+  return file != NULL;
+};
+
+void MotionTrace::append(TraceRecord record){
+  unsigned char bytes[TRACE_RECORD_SIZE];
+  unsigned long count = record.block.count;
+  unsigned long last = record.duration;
+  int length = 0;
+
+  if(file == NULL){
+    return;
+  }
+  if(record.block.type == BLOCK_END){
+    length = strlen(record.block.name);
+    if(length >= TRACE_NAME_SIZE){
+      length = TRACE_NAME_SIZE - 1;
+    }
+    count = length;
+    last = (unsigned long) record.block.count;
+  }
+
+  bytes[0] = record.block.type;
+  bytes[1] = record.block.target;
+  bytes[2] = (record.block.dirX ? 1 : 0) | (record.block.dirY ? 2 : 0);
+  bytes[3] = record.outputs;
+  bytes[4] = count & 0xFF;
+  bytes[5] = (count >> 8) & 0xFF;
+  for(int i = 0; i < 4; i++){
+    bytes[6 + i] = (record.start >> (8 * i)) & 0xFF;
+    bytes[10 + i] = (last >> (8 * i)) & 0xFF;
+  }
+  fwrite(bytes, 1, TRACE_RECORD_SIZE, file);
+
+  if(record.block.type == BLOCK_END){
+    fwrite(record.block.name, 1, length, file);
+    fflush(file);
+  }
+};
+
+bool MotionTrace::readHeader(FILE * file){
+  char magic[4];
+
+  return fread(magic, 1, 4, file) == 4 && memcmp(magic, TRACE_MAGIC, 4) == 0;
+};
+
+bool MotionTrace::readRecord(FILE * file, TraceRecord * record){
+  unsigned char bytes[TRACE_RECORD_SIZE];
+  unsigned long start = 0;
+  unsigned long last = 0;
+
+  if(fread(bytes, 1, TRACE_RECORD_SIZE, file) != TRACE_RECORD_SIZE){
+    return false;
+  }
+  for(int i = 3; i >= 0; i--){
+    start = (start << 8) | bytes[6 + i];
+    last = (last << 8) | bytes[10 + i];
+  }
+
+  record->block.type = bytes[0];
+  record->block.target = bytes[1];
+  record->block.dirX = (bytes[2] & 1) != 0;
+  record->block.dirY = (bytes[2] & 2) != 0;
+  record->block.count = bytes[4] | (bytes[5] << 8);
+  record->block.name = NULL;
+  record->outputs = bytes[3];
+  record->start = start;
+  record->duration = last;
+  record->name[0] = '\0';
+
+  if(record->block.type == BLOCK_END){
+    int length = record->block.count;
+    if(length >= TRACE_NAME_SIZE || fread(record->name, 1, length, file) != (size_t) length){
+      return false;
+    }
+    record->name[length] = '\0';
+    record->block.name = record->name;
+    // the estimated time is a signed number of ms
+    record->block.count = last == 0xFFFFFFFFUL ? -1 : (long) last;
+    record->duration = 0;
+  }
+  return true;
+};
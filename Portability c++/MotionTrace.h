@@ -0,0 +1,117 @@
+/*
+ * Header file for the MotionTrace class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOTIONTRACE_H
+#define MOTIONTRACE_H
+
+#include "Block.h"
+#include <stdio.h>
+
+// First bytes of a trace file (the last one is the version of the format)
+#define TRACE_MAGIC "WCT1"
+
+// Size of a record in the file, the name of a sequence follows its BLOCK_END record
+#define TRACE_RECORD_SIZE 14
+
+// Longest name of a sequence kept in a record
+#define TRACE_NAME_SIZE 32
+
+/**
+ * TraceRecord variables
+ *
+ * block    : the executed block (the name of a BLOCK_END points to the name of the record)
+ * outputs  : the levels of the outputs (OUT_* bits) at the end of the block, so the direction pins, the
+ *            electromagnet and the CNC board
+ * start    : the time (us) of the virtual clock when the block started
+ * duration : the time (us) spent by the block, 0 for a BLOCK_END
+ * name     : the name of the sequence closed by a BLOCK_END
+ */
+struct TraceRecord {
+    Block block;
+    unsigned char outputs;
+    unsigned long start;
+    unsigned long duration;
+    char name[TRACE_NAME_SIZE];
+};
+
+class MotionTrace {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with no file open
+         */
+        MotionTrace();
+
+        /**
+         * Create a trace file (an existing one is overwritten) and write its header
+         *
+         * - Parameters :
+         *      - path : the path of the file
+         *
+         * - Return : false if the file cannot be created
+         */
+        bool open(const char * path);
+
+        /**
+         * Verify if the executed blocks are being recorded
+         *
+         * - Return : true if a trace file is open
+         */
+        bool isOpen();
+
+        /**
+         * Append an executed block to the trace. The file is flushed at the end of any sequence, so the trace
+         * keeps all the completed moves even if the program is stopped
+         *
+         * - Parameters :
+         *      - record : the block with its outputs and its timing
+         */
+        void append(TraceRecord record);
+
+        /**
+         * Verify the header of a trace file opened for reading
+         *
+         * - Parameters :
+         *      - file : the trace file, at its start
+         *
+         * - Return : false if the file is not a trace
+         */
+        static bool readHeader(FILE * file);
+
+        /**
+         * Read the next record of a trace file
+         *
+         * - Parameters :
+         *      - file   : the trace file, after the header
+         *      - record : filled with the record
+         *
+         * - Return : false at the end of the file (or if the last record is truncated)
+         */
+        static bool readRecord(FILE * file, TraceRecord * record);
+
+    private:
+        /**
+         * Private variables
+         *
+         * file : the trace file being written, NULL if the blocks are not recorded
+         */
+        FILE * file;
+};
+
+#endif
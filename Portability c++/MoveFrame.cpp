@@ -0,0 +1,111 @@
+/*
+ * MoveFrame class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MoveFrame.h"
+
+using namespace std;
+
+// Types of piece in the order of the piece field (0 and 7 are not valid)
+static const char PIECES[] = "?PRHBQK?";
+
+// Types of the new piece in the order of the promotion field
+static const char PROMOTIONS[] = "QRBH";
+
+// Number of data bits of a frame, before the CRC
+#define FRAME_DATA_BITS 17
+
+bool MoveFrame::encode(char piece, const char * from, const char * to, char promotion, char frame[MOVE_FRAME_SIZE]){
+  unsigned long data;
+  int type = 0;
+  int promo = 0;
+
+  for(int i = 1; i < 7; i++){
+    if(PIECES[i] == piece){
+      type = i;
+    }
+  }
+  for(int i = 0; i < 4; i++){
+    if(PROMOTIONS[i] == promotion){
+      promo = i;
+    }
+  }
+  if(type == 0 || from[0] < 'A' || from[0] > 'H' || from[1] < '1' || from[1] > '8' ||
+     to[0] < 'A' || to[0] > 'H' || to[1] < '1' || to[1] > '8'){
+    return false;
+  }
+
+  data = ((unsigned long) type << 14) | ((unsigned long) promo << 12) |
+         ((unsigned long) ((from[0] - 'A') * 8 + from[1] - '1') << 6) | ((to[0] - 'A') * 8 + to[1] - '1');
+  data = (data << 7) | crc7(data);
+
+  frame[0] = FRAME_START | ((data >> 18) & 0x3F);
+  frame[1] = FRAME_NEXT | ((data >> 12) & 0x3F);
+  frame[2] = FRAME_NEXT | ((data >> 6) & 0x3F);
+  frame[3] = FRAME_NEXT | (data & 0x3F);
+  return true;
+};
+
+bool MoveFrame::decode(const char frame[MOVE_FRAME_SIZE], char * piece, char from[3], char to[3], char * promotion){
+  unsigned long data = 0;
+
+  for(int i = 0; i < MOVE_FRAME_SIZE; i++){
+    if(((unsigned char) frame[i] & FRAME_MASK) != (i == 0 ? FRAME_START : FRAME_NEXT)){
+      return false;
+    }
+    data = (data << 6) | (frame[i] & 0x3F);
+  }
+  if(crc7(data >> 7) != (data & 0x7F)){
+    return false;
+  }
+  data >>= 7;
+
+  int type = data >> 14;
+  int source = (data >> 6) & 0x3F;
+  int destination = data & 0x3F;
+  if(type == 0 || type == 7 || source == destination){
+    return false;
+  }
+
+  *piece = PIECES[type];
+  *promotion = PROMOTIONS[(data >> 12) & 0x03];
+  from[0] = 'A' + source / 8;
+  from[1] = '1' + source % 8;
+  from[2] = '\0';
+  to[0] = 'A' + destination / 8;
+  to[1] = '1' + destination % 8;
+  to[2] = '\0';
+  return true;
+};
+
+bool MoveFrame::isFrame(const char * command){
+  return ((unsigned char) command[0] & FRAME_MASK) == FRAME_START;
+};
+
+unsigned char MoveFrame::crc7(unsigned long data){
+  unsigned char crc = 0;
+
+  // bitwise, the most significant bit first: 17 bits do not deserve a table
+  for(int i = FRAME_DATA_BITS - 1; i >= 0; i--){
+    bool feedback = ((crc >> 6) ^ (data >> i)) & 0x01;
+    crc = (crc << 1) & 0x7F;
+    if(feedback){
+      crc ^= 0x09;
+    }
+  }
+  return crc;
+};
@@ -0,0 +1,94 @@
+/*
+ * Header file for the MoveFrame class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOVEFRAME_H
+#define MOVEFRAME_H
+
+// Bytes of a binary move frame
+#define MOVE_FRAME_SIZE 4
+
+// The first byte of a frame is 11xxxxxx, the others are 10xxxxxx: a text command is made of 7 bit characters, so
+// the two protocols share the same stream and a lost byte is detected at the start of the next frame
+#define FRAME_START 0xC0
+#define FRAME_NEXT 0x80
+#define FRAME_MASK 0xC0
+
+/*
+ * A frame carries 24 bits, 6 for each byte (the most significant ones first):
+ *
+ *      piece (3) | promotion (2) | from (6) | to (6) | CRC-7 (7)
+ *
+ * piece     : 1 pawn, 2 rook, 3 knight, 4 bishop, 5 queen, 6 king (the type the piece moves as, so a pawn promoted
+ *             on the chessboard is sent as its new type)
+ * promotion : the type of the new piece when a pawn reaches the last row: 0 queen, 1 rook, 2 bishop, 3 knight
+ * from, to  : the cells expressed as row * 8 + col (A1 = 0, A2 = 1, ..., H8 = 63), as the moves of the MoveGenerator
+ * CRC-7     : x^7 + x^3 + 1 over the first 17 bits
+ */
+class MoveFrame {
+    public:
+        /**
+         * Encode a move in a frame (es: by the application that recognizes the speech)
+         *
+         * - Parameters :
+         *      - piece     : the type of the moved piece (same chars used by the Cell class)
+         *      - from      : the source cell (es: "E2")
+         *      - to        : the destination cell (es: "E4")
+         *      - promotion : the type of the new piece if a pawn reaches the last row ('Q', 'R', 'B', 'H')
+         *      - frame     : filled with the MOVE_FRAME_SIZE bytes of the frame
+         *
+         * - Return : false if the piece or a cell is not valid
+         */
+        static bool encode(char piece, const char * from, const char * to, char promotion, char frame[MOVE_FRAME_SIZE]);
+
+        /**
+         * Decode a frame, verifying its CRC
+         *
+         * - Parameters :
+         *      - frame     : the MOVE_FRAME_SIZE bytes of the frame
+         *      - piece     : filled with the type of the moved piece (same chars used by the Cell class)
+         *      - from      : filled with the source cell, as a string (es: "E2")
+         *      - to        : filled with the destination cell, as a string
+         *      - promotion : filled with the type of the new piece if a pawn reaches the last row
+         *
+         * - Return : false if the frame is not valid (the output parameters are not modified)
+         */
+        static bool decode(const char frame[MOVE_FRAME_SIZE], char * piece, char from[3], char to[3], char * promotion);
+
+        /**
+         * Verify if a command is a frame (its first byte is a start of frame)
+         *
+         * - Parameters :
+         *      - command : the command received
+         *
+         * - Return : true if the command must be decoded as a frame
+         */
+        static bool isFrame(const char * command);
+
+    private:
+        /**
+         * Compute the CRC-7 of the first 17 bits of a frame
+         *
+         * - Parameters :
+         *      - data : the 17 bits, in the least significant ones
+         *
+         * - Return : the 7 bit CRC
+         */
+        static unsigned char crc7(unsigned long data);
+};
+
+#endif
@@ -0,0 +1,181 @@
+/*
+ * MoveGenerator class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MoveGenerator.h"
+
+using namespace std;
+
+// Knight jumps and king steps expressed as (row, col) offsets: the even king steps are straight, the odd ones are diagonal
+static const int knightJumps[8][2] = {{1,2},{2,1},{2,-1},{1,-2},{-1,-2},{-2,-1},{-2,1},{-1,2}};
+static const int kingSteps[8][2]   = {{1,0},{1,1},{0,1},{-1,1},{-1,0},{-1,-1},{0,-1},{1,-1}};
+
+// Constructor
+MoveGenerator::MoveGenerator(){};
+
+// Generate implementation
+int MoveGenerator::generate(Cell * cbState[][8], bool turn, Move moves[]){
+  char color = turn ? 'B' : 'W';
+  int count = 0;
+
+  for(int row = 0; row < 8; row++){
+    for(int col = 0; col < 8; col++){
+      // consider only the pieces of the player
+      if(!cbState[row][col]->getBusy() || cbState[row][col]->getColor() != color){
+        continue;
+      }
+
+      switch(cbState[row][col]->getPiece()){
+        case 'P':
+          count = addPawn(cbState, turn, row, col, moves, count);
+          break;
+        case 'H':
+          for(int i = 0; i < 8; i++){
+            count = addStep(cbState, turn, row, col, knightJumps[i][0], knightJumps[i][1], moves, count);
+          }
+          break;
+        case 'K':
+          for(int i = 0; i < 8; i++){
+            count = addStep(cbState, turn, row, col, kingSteps[i][0], kingSteps[i][1], moves, count);
+          }
+          break;
+        case 'B':
+        case 'R':
+        case 'Q':
+          // the even directions of kingSteps are straight, the odd ones are diagonal
+          for(int i = 0; i < 8; i++){
+            if((i % 2 == 0 && cbState[row][col]->getPiece() != 'B') || (i % 2 == 1 && cbState[row][col]->getPiece() != 'R')){
+              count = addSlides(cbState, turn, row, col, kingSteps[i][0], kingSteps[i][1], moves, count);
+            }
+          }
+          break;
+      }
+    }
+  }
+
+  return count;
+};
+
+// Is attacked implementation
+bool MoveGenerator::isAttacked(Cell * cbState[][8], bool turn, int row, int col){
+  char color = turn ? 'B' : 'W';
+  // the white pawns attack toward the 8 row, so they are in the previous column (and vice versa)
+  int back = turn ? 1 : -1;
+
+  if(isPiece(cbState, row - 1, col + back, color, 'P') || isPiece(cbState, row + 1, col + back, color, 'P')){
+    return true;
+  }
+
+  for(int i = 0; i < 8; i++){
+    if(isPiece(cbState, row + knightJumps[i][0], col + knightJumps[i][1], color, 'H') ||
+       isPiece(cbState, row + kingSteps[i][0], col + kingSteps[i][1], color, 'K')){
+      return true;
+    }
+
+    // the first busy cell along any direction: a queen, a rook (straight) or a bishop (diagonal) attacks
+    int r = row + kingSteps[i][0];
+    int c = col + kingSteps[i][1];
+    while(r >= 0 && c >= 0 && r <= 7 && c <= 7 && !cbState[r][c]->getBusy()){
+      r += kingSteps[i][0];
+      c += kingSteps[i][1];
+    }
+    if(isPiece(cbState, r, c, color, 'Q') || isPiece(cbState, r, c, color, i % 2 == 0 ? 'R' : 'B')){
+      return true;
+    }
+  }
+
+  return false;
+};
+
+int MoveGenerator::addSlides(Cell * cbState[][8], bool turn, int row, int col, int dRow, int dCol, Move moves[], int count){
+  int r = row + dRow;
+  int c = col + dCol;
+
+  while(isReachable(cbState, turn, r, c) && count < MAX_MOVES){
+    count = addStep(cbState, turn, row, col, r - row, c - col, moves, count);
+    // the piece cannot slide over a busy cell
+    if(cbState[r][c]->getBusy()){
+      break;
+    }
+    r += dRow;
+    c += dCol;
+  }
+
+  return count;
+};
+
+int MoveGenerator::addStep(Cell * cbState[][8], bool turn, int row, int col, int dRow, int dCol, Move moves[], int count){
+  int r = row + dRow;
+  int c = col + dCol;
+
+  if(count < MAX_MOVES && isReachable(cbState, turn, r, c)){
+    moves[count].from = row * 8 + col;
+    moves[count].to = r * 8 + c;
+    moves[count].piece = cbState[row][col]->getPiece();
+    moves[count].capture = cbState[r][c]->getBusy();
+    count++;
+  }
+
+  return count;
+};
+
+int MoveGenerator::addPawn(Cell * cbState[][8], bool turn, int row, int col, Move moves[], int count){
+  // the white pawns move toward the 8 row, the black ones toward the 1 row
+  int forward = turn ? -1 : 1;
+  int startCol = turn ? 6 : 1;
+  int c = col + forward;
+
+  if(c < 0 || c > 7){
+    return count;
+  }
+
+  // one step forward (and two steps at the first move) only on empty cells
+  if(!cbState[row][c]->getBusy()){
+    count = addStep(cbState, turn, row, col, 0, forward, moves, count);
+    if(col == startCol && !cbState[row][c + forward]->getBusy()){
+      count = addStep(cbState, turn, row, col, 0, 2 * forward, moves, count);
+    }
+  }
+
+  // diagonal movement only to eat an opposing piece
+  for(int dRow = -1; dRow <= 1; dRow += 2){
+    if(row + dRow >= 0 && row + dRow <= 7 && cbState[row + dRow][c]->getBusy()){
+      count = addStep(cbState, turn, row, col, dRow, forward, moves, count);
+    }
+  }
+
+  return count;
+};
+
+bool MoveGenerator::isReachable(Cell * cbState[][8], bool turn, int row, int col){
+  // row or column out of chessboard limits
+  if(row < 0 || col < 0 || row > 7 || col > 7){
+    return false;
+  }
+  // a cell busy by a piece of the same color cannot be reached
+  if(cbState[row][col]->getBusy() && cbState[row][col]->getColor() == (turn ? 'B' : 'W')){
+    return false;
+  }
+  return true;
+};
+
+bool MoveGenerator::isPiece(Cell * cbState[][8], int row, int col, char color, char piece){
+  if(row < 0 || col < 0 || row > 7 || col > 7){
+    return false;
+  }
+  return cbState[row][col]->getBusy() && cbState[row][col]->getColor() == color && cbState[row][col]->getPiece() == piece;
+};
@@ -0,0 +1,157 @@
+/*
+ * Header file for the MoveGenerator class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MOVEGENERATOR_H
+#define MOVEGENERATOR_H
+
+#include "Cell.h"
+
+// Maximum number of moves that a player can have in a position
+#define MAX_MOVES 128
+
+/**
+ * Move variables
+ *
+ * from    : the source cell of the move expressed as row * 8 + col (row and col are the indexes in the cbState)
+ * to      : the destination cell of the move expressed as row * 8 + col
+ * piece   : the type of the moved piece (same chars used by the Cell class)
+ * capture : true if the destination cell is busy by an opponent piece
+ */
+struct Move {
+    unsigned char from;
+    unsigned char to;
+    char piece;
+    bool capture;
+};
+
+class MoveGenerator {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class
+         */
+        MoveGenerator();
+
+        /**
+         * Generate all the moves that the player can perform in the position, following the same rules
+         * verified by the managers (N.B.: as for the managers, the moves leaving the king under attack
+         * are not discarded)
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - turn    : indicates if move the white (false) or the black (true)
+         *      - moves   : the list (at least MAX_MOVES long) filled with the moves found
+         *
+         * - Return : the number of moves found
+         */
+        int generate(Cell * cbState[][8], bool turn, Move moves[]);
+
+        /**
+         * Verify if a cell is attacked by a piece of a player (es: the cells crossed by the king while castling)
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - turn    : indicates the player whose pieces attack: the white (false) or the black (true)
+         *      - row     : the row index of the cell in the cbState
+         *      - col     : the column index of the cell in the cbState
+         *
+         * - Return : true if at least a piece of the player can reach the cell with its next move
+         */
+        bool isAttacked(Cell * cbState[][8], bool turn, int row, int col);
+
+    private:
+        /**
+         * Add the moves of a piece that slides (bishop, rook, queen) along a direction until the
+         * first busy cell
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - turn    : indicates if move the white (false) or the black (true)
+         *      - row     : the row index of the piece in the cbState
+         *      - col     : the column index of the piece in the cbState
+         *      - dRow    : the row increment of the direction
+         *      - dCol    : the column increment of the direction
+         *      - moves   : the list of moves to fill
+         *      - count   : the number of moves already in the list
+         *
+         * - Return : the new number of moves in the list
+         */
+        int addSlides(Cell * cbState[][8], bool turn, int row, int col, int dRow, int dCol, Move moves[], int count);
+
+        /**
+         * Add the move of a piece that jumps (knight, king) to a single cell
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - turn    : indicates if move the white (false) or the black (true)
+         *      - row     : the row index of the piece in the cbState
+         *      - col     : the column index of the piece in the cbState
+         *      - dRow    : the row offset of the destination
+         *      - dCol    : the column offset of the destination
+         *      - moves   : the list of moves to fill
+         *      - count   : the number of moves already in the list
+         *
+         * - Return : the new number of moves in the list
+         */
+        int addStep(Cell * cbState[][8], bool turn, int row, int col, int dRow, int dCol, Move moves[], int count);
+
+        /**
+         * Add the moves of a pawn (one and two steps forward, diagonal captures)
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - turn    : indicates if move the white (false) or the black (true)
+         *      - row     : the row index of the pawn in the cbState
+         *      - col     : the column index of the pawn in the cbState
+         *      - moves   : the list of moves to fill
+         *      - count   : the number of moves already in the list
+         *
+         * - Return : the new number of moves in the list
+         */
+        int addPawn(Cell * cbState[][8], bool turn, int row, int col, Move moves[], int count);
+
+        /**
+         * Verify if a cell can be the destination of a move of the player
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - turn    : indicates if move the white (false) or the black (true)
+         *      - row     : the row index of the cell in the cbState
+         *      - col     : the column index of the cell in the cbState
+         *
+         * - Return : true if the cell is inside the chessboard and not busy by a piece of the player
+         */
+        bool isReachable(Cell * cbState[][8], bool turn, int row, int col);
+
+        /**
+         * Verify if a cell is busy by a given piece
+         *
+         * - Parameters :
+         *      - cbState : indicates the position of all the pieces on the chessboard
+         *      - row     : the row index of the cell in the cbState
+         *      - col     : the column index of the cell in the cbState
+         *      - color   : the color of the piece ('W' or 'B')
+         *      - piece   : the type of the piece
+         *
+         * - Return : true if the cell is inside the chessboard and busy by the piece
+         */
+        bool isPiece(Cell * cbState[][8], int row, int col, char color, char piece);
+};
+
+#endif
@@ -0,0 +1,66 @@
+/*
+ * Header file for the ParsedCommand structure.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PARSEDCOMMAND_H
+#define PARSEDCOMMAND_H
+
+#include "CommandParser.h"
+
+// Longest command, terminator included (as the lines of the standard input)
+#define PARSED_COMMAND_SIZE 256
+
+// Largest number of words of a command (a word has at least a letter and a space)
+#define MAX_WORDS (PARSED_COMMAND_SIZE / 2)
+
+/**
+ * ParsedCommand variables
+ *
+ * The parsing does not depend on the position, so it is done before the command waits to be executed: the
+ * hypotheses and the words are kept as offsets in their own buffers, so the structure can be copied
+ *
+ * text          : the command, as read from the standard input or framed by a CommandReader
+ * frame         : indicates if the command is a binary frame (a move already recognized by the phone)
+ * decoded       : indicates if the binary frame is valid (piece, from, to and promotion are its move)
+ * piece         : the type of the moved piece of a frame (same chars used by the Cell class)
+ * from          : the coordinates of the source cell of a frame
+ * to            : the coordinates of the destination cell of a frame
+ * promotion     : the type of the new piece of a frame
+ * hypotheses    : the hypotheses of the speech recognizer (es: PEDINA A E4|PEDINA A E5), each one terminated
+ * hypothesis    : the offset of each hypothesis in hypotheses
+ * numHypotheses : the number of hypotheses
+ * words         : the words of the command in uppercase (but the ones of a FEN string), each one terminated
+ * word          : the offset of each word in words
+ * numWords      : the number of words
+ */
+struct ParsedCommand {
+    char text[PARSED_COMMAND_SIZE];
+    bool frame;
+    bool decoded;
+    char piece;
+    char from[3];
+    char to[3];
+    char promotion;
+    char hypotheses[PARSED_COMMAND_SIZE];
+    unsigned char hypothesis[MAX_HYPOTHESES];
+    int numHypotheses;
+    char words[PARSED_COMMAND_SIZE + 1];
+    unsigned char word[MAX_WORDS];
+    int numWords;
+};
+
+#endif
@@ -0,0 +1,278 @@
+/*
+ * PathPlanner class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PathPlanner.h"
+#include "RouteTable.h"
+#include <stdlib.h>
+
+using namespace std;
+
+// Flag of the open nodes, kept as a bit set
+#define OPEN(node) ((openNodes[(node) / 8] >> ((node) % 8)) & 1)
+
+// Directions of the grid: the even ones are along an axis, the odd ones are diagonal
+static const int directions[8][2] = {{1,0},{1,1},{0,1},{-1,1},{-1,0},{-1,-1},{0,-1},{1,-1}};
+
+// Constructor
+PathPlanner::PathPlanner(){
+  for(int i = 0; i < AREA_COLUMNS; i++){
+    occupied[i] = 0;
+  }
+};
+
+void PathPlanner::setObstacles(Cell * cbState[][8], unsigned short whiteCemetery, unsigned short blackCemetery){
+  unsigned short cemetery[2] = {whiteCemetery, blackCemetery};
+  int x;
+  int y;
+
+  for(int i = 0; i < AREA_COLUMNS; i++){
+    occupied[i] = 0;
+  }
+
+  // chessboard cells
+  for(int row = 0; row < 8; row++){
+    for(int col = 0; col < 8; col++){
+      if(cbState[row][col]->getBusy()){
+        occupied[row + CEMETERY_COLUMNS] |= 1 << col;
+      }
+    }
+  }
+
+  // cemetery spaces
+  for(int color = WHITE; color <= BLACK; color++){
+    for(int slot = 0; slot < 16; slot++){
+      if((cemetery[color] >> slot) & 1){
+        cemeteryCell(color, slot, &x, &y);
+        occupied[x + CEMETERY_COLUMNS] |= 1 << y;
+      }
+    }
+  }
+};
+
+// Plan implementation (A* search on the half-cell grid)
+int PathPlanner::plan(int fromX, int fromY, int toX, int toY, Waypoint path[]){
+  start = (2 * fromY + 1) * GRID_WIDTH + 2 * (fromX + CEMETERY_COLUMNS) + 1;
+  goal = (2 * toY + 1) * GRID_WIDTH + 2 * (toX + CEMETERY_COLUMNS) + 1;
+  int goalX = goal % GRID_WIDTH;
+  int goalY = goal / GRID_WIDTH;
+
+  if(fromX < -CEMETERY_COLUMNS || toX < -CEMETERY_COLUMNS || fromX >= 8 + CEMETERY_COLUMNS || toX >= 8 + CEMETERY_COLUMNS ||
+     fromY < 0 || toY < 0 || fromY > 7 || toY > 7){
+    return 0;
+  }
+
+#ifndef ROUTE_TABLE_GENERATOR
+  // the route of the empty chessboard is still the fastest one if no piece is on the way
+  int numCached = cachedRoute(fromX, fromY, toX, toY, path);
+  if(numCached > 0){
+    return numCached;
+  }
+#endif
+
+  for(int i = 0; i < GRID_NODES; i++){
+    cost[i] = 0xFFFF;
+    bestDirections[i] = 0;
+  }
+  for(int i = 0; i < GRID_NODES / 8 + 1; i++){
+    openNodes[i] = 0;
+  }
+  cost[start] = 0;
+  openNodes[start / 8] |= 1 << (start % 8);
+
+  while(true){
+    // select the open node with the lowest estimated total time (on equal terms, the nearest to the goal)
+    int node = -1;
+    long bestF = 0;
+    long bestH = 0;
+    for(int i = 0; i < GRID_NODES; i++){
+      if(OPEN(i)){
+        // the heuristic is the time of the straight route, ignoring the changes of direction
+        int dx = abs(i % GRID_WIDTH - goalX);
+        int dy = abs(i / GRID_WIDTH - goalY);
+        long h = (dx > dy ? dx : dy) * HALF_CELL_TIME;
+        long f = cost[i] + h;
+        if(node < 0 || f < bestF || (f == bestF && h < bestH)){
+          node = i;
+          bestF = f;
+          bestH = h;
+        }
+      }
+    }
+
+    // there is not a route
+    if(node < 0){
+      return 0;
+    }
+    if(node == goal){
+      break;
+    }
+
+    openNodes[node / 8] &= ~(1 << (node % 8));
+
+    int hx = node % GRID_WIDTH;
+    int hy = node / GRID_WIDTH;
+    for(int d = 0; d < 8; d++){
+      if(!canStep(hx, hy, d)){
+        continue;
+      }
+      int next = (hy + directions[d][1]) * GRID_WIDTH + hx + directions[d][0];
+      // continuing in one of the directions of the best routes to the node is free, any other direction
+      // costs the time needed by the stepper motors to change direction (the source has no direction)
+      long time = cost[node] + HALF_CELL_TIME;
+      if(node != start && !((bestDirections[node] >> d) & 1)){
+        time += DIR_DELAY;
+      }
+      if(time < cost[next]){
+        cost[next] = time;
+        bestDirections[next] = 1 << d;
+        openNodes[next / 8] |= 1 << (next % 8);
+      } else if(time == cost[next] && !((bestDirections[next] >> d) & 1)){
+        // a new direction to continue for free: the node must be expanded again
+        bestDirections[next] |= 1 << d;
+        openNodes[next / 8] |= 1 << (next % 8);
+      }
+    }
+  }
+
+  // walk the route back from the goal keeping only the nodes where the direction changes
+  Waypoint reversed[MAX_WAYPOINTS];
+  int numWaypoints = 0;
+  int node = goal;
+  int dir = -1;
+  while(true){
+    // keep the current direction while it is one of the best ones
+    if(dir < 0 || !((bestDirections[node] >> dir) & 1)){
+      if(numWaypoints == MAX_WAYPOINTS){
+        return 0;
+      }
+      reversed[numWaypoints].x = (node % GRID_WIDTH - 2 * CEMETERY_COLUMNS - 1) * (STEPS / 2);
+      reversed[numWaypoints].y = (node / GRID_WIDTH - 1) * (STEPS / 2);
+      numWaypoints++;
+
+      // the source has been reached
+      if(bestDirections[node] == 0){
+        break;
+      }
+      dir = 0;
+      while(!((bestDirections[node] >> dir) & 1)){
+        dir++;
+      }
+    }
+    node -= directions[dir][1] * GRID_WIDTH + directions[dir][0];
+  }
+
+  for(int i = 0; i < numWaypoints; i++){
+    path[i] = reversed[numWaypoints - 1 - i];
+  }
+  return numWaypoints;
+};
+
+#ifndef ROUTE_TABLE_GENERATOR
+int PathPlanner::cachedRoute(int fromX, int fromY, int toX, int toY, Waypoint path[]){
+  int numWaypoints = RouteTable::route(fromX, fromY, toX, toY, path);
+
+  // walk any segment of the route half cell at a time
+  for(int i = 1; i < numWaypoints; i++){
+    int hx = path[i - 1].x / (STEPS / 2) + 2 * CEMETERY_COLUMNS + 1;
+    int hy = path[i - 1].y / (STEPS / 2) + 1;
+    int dx = path[i].x > path[i - 1].x ? 1 : (path[i].x < path[i - 1].x ? -1 : 0);
+    int dy = path[i].y > path[i - 1].y ? 1 : (path[i].y < path[i - 1].y ? -1 : 0);
+    int length = abs(path[i].x - path[i - 1].x) > abs(path[i].y - path[i - 1].y) ?
+                 abs(path[i].x - path[i - 1].x) / (STEPS / 2) : abs(path[i].y - path[i - 1].y) / (STEPS / 2);
+    int dir = 0;
+    while(directions[dir][0] != dx || directions[dir][1] != dy){
+      dir++;
+    }
+
+    for(int j = 0; j < length; j++){
+      if(!canStep(hx, hy, dir)){
+        return 0;
+      }
+      hx += dx;
+      hy += dy;
+    }
+  }
+
+  return numWaypoints;
+};
+#endif
+
+void PathPlanner::cemeteryCell(bool color, int slot, int * x, int * y){
+  // the first 8 spaces are in the column next to the chessboard
+  if(color == WHITE){
+    *x = -1 - slot / 8;
+  } else {
+    *x = 8 + slot / 8;
+  }
+  *y = slot % 8;
+};
+
+int PathPlanner::cemeterySlot(int x, int y){
+  if(x < 0){
+    return (-1 - x) * 8 + y;
+  } else if(x > 7){
+    return (x - 8) * 8 + y;
+  }
+  return -1;
+};
+
+long PathPlanner::routeTime(Waypoint path[], int numWaypoints){
+  long time = 0;
+
+  for(int i = 1; i < numWaypoints; i++){
+    int dx = abs(path[i].x - path[i - 1].x);
+    int dy = abs(path[i].y - path[i - 1].y);
+    // the segments are along an axis or along a diagonal
+    time += DIR_DELAY + (dx > dy ? dx : dy) / (STEPS / 2) * HALF_CELL_TIME;
+  }
+  return time;
+};
+
+bool PathPlanner::isBlocked(int hx, int hy){
+  // only the centers of the cells can be busy: the transported piece can slide along the edges
+  if(hx % 2 == 0 || hy % 2 == 0){
+    return false;
+  }
+  int node = hy * GRID_WIDTH + hx;
+  if(node == start || node == goal){
+    return false;
+  }
+  return (occupied[(hx - 1) / 2] >> ((hy - 1) / 2)) & 1;
+};
+
+bool PathPlanner::canStep(int hx, int hy, int dir){
+  int nx = hx + directions[dir][0];
+  int ny = hy + directions[dir][1];
+
+  // out of the area covered by the solenoid
+  if(nx < 0 || ny < 0 || nx >= GRID_WIDTH || ny >= GRID_HEIGHT){
+    return false;
+  }
+  if(isBlocked(nx, ny)){
+    return false;
+  }
+  // a diagonal step between the middle points of two edges cuts the corner of the cell between them
+  if(dir % 2 == 1 && (hx + hy) % 2 == 1){
+    if(hx % 2 == 1){
+      return !isBlocked(hx, ny);
+    } else {
+      return !isBlocked(nx, hy);
+    }
+  }
+  return true;
+};
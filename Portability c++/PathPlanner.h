@@ -0,0 +1,187 @@
+/*
+ * Header file for the PathPlanner class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PATHPLANNER_H
+#define PATHPLANNER_H
+
+#include "Cell.h"
+#include "Config.h"
+
+// Number of columns of cells covered by the solenoid: the chessboard plus the two cemeteries
+#define AREA_COLUMNS (8 + 2 * CEMETERY_COLUMNS)
+
+// Half-cell grid: the nodes are the centers, the middle points of the edges and the corners of the cells
+#define GRID_WIDTH (2 * AREA_COLUMNS + 1)
+#define GRID_HEIGHT (2 * 8 + 1)
+#define GRID_NODES (GRID_WIDTH * GRID_HEIGHT)
+
+// Time (ms) to cross half a cell, both along an axis and along a diagonal (the two stepper motors move together)
+#define HALF_CELL_TIME ((STEPS / 2) * 2L * STEP_DELAY / 1000)
+
+// Maximum number of waypoints of a route
+#define MAX_WAYPOINTS 32
+
+/**
+ * Waypoint variables
+ *
+ * x : the position along the X axis, expressed in steps from the center of the A1 cell
+ * y : the position along the Y axis, expressed in steps from the center of the A1 cell
+ */
+struct Waypoint {
+    int x;
+    int y;
+};
+
+class PathPlanner {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class
+         */
+        PathPlanner();
+
+        /**
+         * Load the cells busy by a piece, on the chessboard and in the cemeteries, that the transported piece
+         * must avoid
+         *
+         * - Parameters :
+         *      - cbState       : indicates the position of all the pieces on the chessboard
+         *      - whiteCemetery : the busy spaces of the white cemetery (bit i = space i)
+         *      - blackCemetery : the busy spaces of the black cemetery (bit i = space i)
+         */
+        void setObstacles(Cell * cbState[][8], unsigned short whiteCemetery, unsigned short blackCemetery);
+
+        /**
+         * Find the fastest route to transport a piece from a source cell to a destination cell passing through
+         * the centers and the edges of the cells, without touching the busy cells. The cost of a route is its
+         * travel time: HALF_CELL_TIME for any half cell and DIR_DELAY for any change of direction.
+         * N.B.: the columns of the cells go from -CEMETERY_COLUMNS (white cemetery) to 7 + CEMETERY_COLUMNS
+         *       (black cemetery), where 0 is the A column; the rows go from 0 (row 1) to 7 (row 8).
+         *       The source and the destination cells are never considered as obstacles.
+         *       The route of the empty chessboard stored in the RouteTable is used when none of the cells
+         *       on it is busy: the search is performed only to repair the routes blocked by a piece.
+         *
+         * - Parameters :
+         *      - fromX : the column of the source cell
+         *      - fromY : the row of the source cell
+         *      - toX   : the column of the destination cell
+         *      - toY   : the row of the destination cell
+         *      - path  : the list (at least MAX_WAYPOINTS long) filled with the waypoints of the route, from the
+         *                source to the destination (the solenoid moves in straight line between two waypoints)
+         *
+         * - Return : the number of waypoints of the route (0 if there is not a route)
+         */
+        int plan(int fromX, int fromY, int toX, int toY, Waypoint path[]);
+
+        /**
+         * Find the cell corresponding to a space of a cemetery
+         *
+         * - Parameters :
+         *      - color : the color of the cemetery (WHITE or BLACK)
+         *      - slot  : the index of the space in the cemetery (0 - 15)
+         *      - x     : filled with the column of the cell
+         *      - y     : filled with the row of the cell
+         */
+        static void cemeteryCell(bool color, int slot, int * x, int * y);
+
+        /**
+         * Find the space of a cemetery corresponding to a cell
+         *
+         * - Parameters :
+         *      - x : the column of the cell
+         *      - y : the row of the cell
+         *
+         * - Return : the index of the space in the cemetery of its side (0 - 15), -1 if the cell is on the chessboard
+         */
+        static int cemeterySlot(int x, int y);
+
+        /**
+         * Estimate the time needed to travel along a route: HALF_CELL_TIME for any half cell and DIR_DELAY
+         * for any segment (the direction of the stepper motors is set at the start of any segment)
+         *
+         * - Parameters :
+         *      - path         : the list of the waypoints of the route
+         *      - numWaypoints : the number of waypoints of the route
+         *
+         * - Return : the travel time (ms)
+         */
+        static long routeTime(Waypoint path[], int numWaypoints);
+
+    private:
+        /**
+         * Load the route of the empty chessboard from the RouteTable and verify that it does not touch
+         * any busy cell
+         *
+         * - Parameters :
+         *      - fromX : the column of the source cell
+         *      - fromY : the row of the source cell
+         *      - toX   : the column of the destination cell
+         *      - toY   : the row of the destination cell
+         *      - path  : the list filled with the waypoints of the route
+         *
+         * - Return : the number of waypoints of the route (0 if the route touches a busy cell)
+         */
+        int cachedRoute(int fromX, int fromY, int toX, int toY, Waypoint path[]);
+
+        /**
+         * Verify if a node of the grid is the center of a cell busy by a piece
+         *
+         * - Parameters :
+         *      - hx : the column of the node in the grid
+         *      - hy : the row of the node in the grid
+         *
+         * - Return : true if the transported piece cannot pass through the node
+         */
+        bool isBlocked(int hx, int hy);
+
+        /**
+         * Verify if the transported piece can move from a node to the next one along a direction
+         *
+         * - Parameters :
+         *      - hx  : the column of the node in the grid
+         *      - hy  : the row of the node in the grid
+         *      - dir : the index of the direction (even = along an axis, odd = diagonal)
+         *
+         * - Return : true if the step is inside the grid and does not touch a busy cell
+         */
+        bool canStep(int hx, int hy, int dir);
+
+        /**
+         * Private variables
+         *
+         * occupied       : for any column of cells, the bit y is set if the cell in the row y is busy
+         * cost           : the travel time of the best route found from the source to any node
+         * bestDirections : for any node, the bit d is set if a best route reaches the node along the direction d
+         *                  (continuing along one of these directions does not require a change of direction)
+         * openNodes      : the bit of a node is set if the node must be expanded (it has been reached for the first
+         *                  time, with a lower time or along a new best direction)
+         * start          : the node of the source cell
+         * goal           : the node of the destination cell
+         *
+         * N.B.: the search uses about 1.3 KB of RAM that are allocated with the object
+         */
+        unsigned char occupied[AREA_COLUMNS];
+        unsigned short cost[GRID_NODES];
+        unsigned char bestDirections[GRID_NODES];
+        unsigned char openNodes[GRID_NODES / 8 + 1];
+        int start;
+        int goal;
+};
+
+#endif
@@ -36,9 +36,10 @@ Pawn::Pawn(const char * initialPosition): Piece(initialPosition) {
 
 char * Pawn::getPromotion(){
   // create a copy to return the pointer in a safety way
-  char * copy = new char [strlen(pawnPromotion)];
+  char * copy = new char [strlen(pawnPromotion) + 1];
     
-  for(int i=0; i<strlen(pawnPromotion); i++){
+  // the terminal character is copied too
+  for(int i=0; i<=strlen(pawnPromotion); i++){
       copy[i] = pawnPromotion[i];
   }
     
@@ -50,9 +51,10 @@ bool Pawn::getFirstMove(){
 };
 
 void Pawn::setPromotion(const char * newType){
-  pawnPromotion = new char [strlen(newType)];
+  pawnPromotion = new char [strlen(newType) + 1];
     
-  for(int i = 0; i<strlen(newType); i++){
+  // the terminal character is copied too
+  for(int i = 0; i<=strlen(newType); i++){
       pawnPromotion[i] = newType[i];
   }
 };
@@ -110,9 +110,10 @@ char * PawnsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
               }
 
               setNewPosition(turn, from, destination);
-              candidate = new char[2];
+              candidate = new char[3];
               candidate[0] = from[0];
               candidate[1] = from[1];
+              candidate[2] = '\0';
               return candidate;
             }
           }
@@ -131,14 +132,16 @@ char * PawnsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
 
                     // a two-step movement generate the possibility for the opponent player to perform an en passant in the next move
                     if(turn){   // if move black
-                        enPassantWhite = new char[2];
+                        enPassantWhite = new char[3];
                         enPassantWhite[0] = destination[0];
                         enPassantWhite[1] = destination[1];
+                        enPassantWhite[2] = '\0';
                         enPassantBlack = NULL;
                     } else{     // if move white
-                        enPassantBlack = new char[2];
+                        enPassantBlack = new char[3];
                         enPassantBlack[0] = destination[0];
                         enPassantBlack[1] = destination[1];
+                        enPassantBlack[2] = '\0';
                         enPassantWhite = NULL;
                     }
 
@@ -148,9 +151,10 @@ char * PawnsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
                     }
 
                     setNewPosition(turn, from, destination);
-                    candidate = new char[2];
+                    candidate = new char[3];
                     candidate[0] = from[0];
                     candidate[1] = from[1];
+                    candidate[2] = '\0';
                     return candidate;
                 }
             }
@@ -172,9 +176,10 @@ char * PawnsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
               }
 
               setNewPosition(turn, from, destination);
-              candidate = new char[2];
+              candidate = new char[3];
               candidate[0] = from[0];
               candidate[1] = from[1];
+              candidate[2] = '\0';
               return candidate;
             }
           }
@@ -194,9 +199,10 @@ char * PawnsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
               }
 
               setNewPosition(turn, from, destination);
-              candidate = new char[2];
+              candidate = new char[3];
               candidate[0] = from[0];
               candidate[1] = from[1];
+              candidate[2] = '\0';
               return candidate;
             }
 
@@ -217,9 +223,10 @@ char * PawnsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
               }
 
               setNewPosition(turn, from, destination);
-              candidate = new char[2];
+              candidate = new char[3];
               candidate[0] = from[0];
               candidate[1] = from[1];
+              candidate[2] = '\0';
               return candidate;
             }
           }
@@ -232,15 +239,17 @@ char * PawnsManager::checkCandidates(Cell * cbState[][8], bool turn, const char
         // a two-step movement generate the possibility for the opponent player to perform an en passant in the next move
         if(turn){   // if move black
 
-          enPassantWhite = new char[2];
+          enPassantWhite = new char[3];
           enPassantWhite[0] = destination[0];
           enPassantWhite[1] = destination[1];
+          enPassantWhite[2] = '\0';
           enPassantBlack = NULL;
         } else{     // if move white
 
-          enPassantBlack = new char[2];
+          enPassantBlack = new char[3];
           enPassantBlack[0] = destination[0];
           enPassantBlack[1] = destination[1];
+          enPassantBlack[2] = '\0';
           enPassantWhite = NULL;
         }
       } else {
@@ -281,8 +290,8 @@ char * PawnsManager::checkPromotedCandidates(Cell * cbState[][8], bool turn, con
         return NULL;
       }
       if(from != NULL && checkSource(cbState, turn, from, 'P')){
-        candidate = new char[2];
-            for(int i = 0; i<strlen(from);i++){
+        candidate = new char[3];
+            for(int i = 0; i<=strlen(from);i++){
             candidate[i] = from[i];
         }
         return candidate;
@@ -403,3 +412,56 @@ void PawnsManager::findAndRemove(bool turn, const char * destination){
     }
   }
 };
+
+const char * PawnsManager::getEnPassant(bool turn){
+  return turn ? enPassantBlack : enPassantWhite;
+};
+
+void PawnsManager::clearEnPassant(bool turn){
+  if(turn){
+    enPassantBlack = NULL;
+  } else {
+    enPassantWhite = NULL;
+  }
+};
+
+void PawnsManager::enPassant(bool turn, const char * from, const char * destination){
+  setNewPosition(turn, from, destination);
+  enPassantBlack = NULL;
+  enPassantWhite = NULL;
+};
+
+void PawnsManager::promote(bool turn, const char * position, const char * promoType){
+  for(int i = 0; i < 8; i++){
+    if(strncmp(pawns[turn][i].getPosition(),position,2) == 0 && pawns[turn][i].getAlive()){
+      pawns[turn][i].setPromotion(promoType);
+
+      return;
+    }
+  }
+};
+
+// SetUp implementation
+bool PawnsManager::setUp(bool turn, char positions[][3], int count){
+  if(count > 8){
+    return false;
+  }
+
+  for(int i = 0; i < 8; i++){
+    if(i < count){
+      pawns[turn][i] = Pawn(positions[i]);
+      // a pawn out of its initial row cannot perform the double step
+      if(positions[i][1] != (turn ? '7' : '2')){
+        pawns[turn][i].setFirstMove();
+      }
+    } else if(pawns[turn][i].getAlive()){
+      pawns[turn][i].setAlive();
+    }
+  }
+
+  // no en passant is available in a new position
+  enPassantWhite = NULL;
+  enPassantBlack = NULL;
+
+  return true;
+};
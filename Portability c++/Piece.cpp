@@ -23,21 +23,24 @@
 
 using namespace std;
 
-Piece::Piece(){};
+Piece::Piece(){
+  position[0] = '\0';
+};
 
 Piece::Piece(const char * initialPosition){
   ////Serial.println(initialPosition);
-  position = new char[3];
   position[0] = initialPosition[0];
   position[1] = initialPosition[1];
+  position[2] = '\0';
   alive = true;
 };
 
 char * Piece::getPosition(){
   // get position in a safety way
-  char * copy = new char [strlen(position)];
+  char * copy = new char [strlen(position) + 1];
     
-  for(int i=0; i<strlen(position); i++){
+  // the terminal character is copied too
+  for(int i=0; i<=strlen(position); i++){
       copy[i] = position[i];
   }
   
@@ -81,9 +81,9 @@ class Piece {
          *  
          * - Parameters :
          *      - position : string that represents the coordinates of the position
-         *                   of the piece
+         *                   of the piece (kept in the piece, so a copy of a manager does not share it)
          */
-        char * position;
+        char position[3];
         bool alive;
 };
 
@@ -56,7 +56,7 @@ char * QueensManager::checkCandidates(Cell * cbState[][8], bool turn, const char
     hDiff = destination[0] - queens[turn][0].getPosition()[0];
   } else{               // ambiguous cases --> from ≠ NULL
     // control if actually a queen of the player occupy the position expressed by the variable from
-    if(checkSource(cbState, turn, from, 'Q')){
+    if(!checkSource(cbState, turn, from, 'Q')){
       return NULL;
     }
     // calculate the vertical difference yd - yf
@@ -131,12 +131,12 @@ bool QueensManager::checkPathIsFree(Cell * cbState[][8], int vDiff, int hDiff, i
         }
       } else if(vDiff > 0 && hDiff < 0){  // up - left real chessboard (from white player point of view)
         // cell busy
-        if(cbState[row - i][col + i]->getBusy()){
+        if(cbState[row + i][col - i]->getBusy()){
           return false;
         }
       } else if(vDiff < 0 && hDiff > 0){  // down - right real chessboard (from white player point of view)
         // cell busy
-        if(cbState[row + i][col - i]->getBusy()){
+        if(cbState[row - i][col + i]->getBusy()){
           return false;
         }
       } else if(vDiff < 0 && hDiff < 0){  // down - left real chessboard (from white player point of view)
@@ -176,8 +176,33 @@ void QueensManager::setNewPosition(bool turn, const char * from, const char * de
 };
 
 void QueensManager::findAndRemove(bool turn, const char * destination){
-  if(strcmp(queens[turn][0].getPosition(),destination) == 0){
+  if(strcmp(queens[!turn][0].getPosition(),destination) == 0){
+      queens[!turn][0].setAlive();
+      queens[!turn][0].setPosition("Z9");
+  }
+};
+
+bool QueensManager::revive(bool turn, const char * destination){
+  if(!queens[turn][0].getAlive()){
       queens[turn][0].setAlive();
-      queens[turn][0].setPosition("Z9");
+      queens[turn][0].setPosition(destination);
+      return true;
   }
+  return false;
+};
+
+// SetUp implementation
+bool QueensManager::setUp(bool turn, char positions[][3], int count){
+  if(count > 1){
+    return false;
+  }
+
+  for(int i = 0; i < 1; i++){
+    if(i < count){
+      queens[turn][i] = Queen(positions[i]);
+    } else if(queens[turn][i].getAlive()){
+      queens[turn][i].setAlive();
+    }
+  }
+  return true;
 };
@@ -65,7 +65,7 @@ char * RooksManager::checkCandidates(Cell * cbState[][8], bool turn, const char
         hDiff = destination[0] - rooks[turn][i].getPosition()[0];
       } else{               // ambiguous cases --> from ≠ NULL
         // control if actually a rook of the player occupy the position expressed by the variable from
-        if(checkSource(cbState, turn, from, 'R')){
+        if(!checkSource(cbState, turn, from, 'R')){
           return NULL;
         }
         // calculate the vertical difference yd - yf
@@ -90,7 +90,7 @@ char * RooksManager::checkCandidates(Cell * cbState[][8], bool turn, const char
 
               setNewPosition(turn, from, destination);
               candidate = new char[3];
-              for(int i = 0; i<strlen(from);i++){
+              for(int i = 0; i<=strlen(from);i++){
                   candidate[i] = from[i];
               }
               return candidate;
@@ -116,18 +116,19 @@ char * RooksManager::checkCandidates(Cell * cbState[][8], bool turn, const char
 
 // checkPathIsFree implementation
 bool RooksManager::checkPathIsFree(Cell * cbState[][8], int vDiff, int hDiff, int row, int col){
-  // consider the parameters from and destination as points ( from = (xf,yf), destination = (xd,yd))
+  // consider the parameters from and destination as points ( from = (xf,yf), destination = (xd,yd)):
+  // the cells between them are visited going back from the destination
 
   if(abs(vDiff) > 0 && hDiff == 0){           // vertical movement
     for(int i = 1; i < abs(vDiff); i++){
       if(vDiff > 0){
         // cell busy
-        if(cbState[row][col + i]->getBusy()){
+        if(cbState[row][col - i]->getBusy()){
           return false;
         }
       } else {
         // cell busy
-        if(cbState[row][col - i]->getBusy()){
+        if(cbState[row][col + i]->getBusy()){
           return false;
         }
       }
@@ -136,12 +137,12 @@ bool RooksManager::checkPathIsFree(Cell * cbState[][8], int vDiff, int hDiff, in
     for(int i = 1; i < abs(hDiff); i++){
       if(hDiff > 0){
         // cell busy
-        if(cbState[row + i][col]->getBusy()){
+        if(cbState[row - i][col]->getBusy()){
           return false;
         }
       } else {
         // cell busy
-        if(cbState[row - i][col]->getBusy()){
+        if(cbState[row + i][col]->getBusy()){
           return false;
         }
       }
@@ -183,11 +184,43 @@ void RooksManager::setNewPosition(bool turn, const char * from, const char * des
 
 void RooksManager::findAndRemove(bool turn, const char * destination){
   for(int i = 0; i < 2; i++){
-    if(strcmp(rooks[turn][i].getPosition(),destination) == 0){
-      rooks[turn][i].setAlive();
-      rooks[turn][i].setPosition("Z9");
+    if(strcmp(rooks[!turn][i].getPosition(),destination) == 0){
+      rooks[!turn][i].setAlive();
+      rooks[!turn][i].setPosition("Z9");
 
       return;
     }
   }
 };
+
+bool RooksManager::revive(bool turn, const char * destination){
+  for(int i = 0; i < 2; i++){
+    if(!rooks[turn][i].getAlive()){
+      rooks[turn][i].setAlive();
+      rooks[turn][i].setPosition(destination);
+
+      return true;
+    }
+  }
+  return false;
+};
+
+void RooksManager::castle(bool turn, const char * from, const char * destination){
+  setNewPosition(turn, from, destination);
+};
+
+// SetUp implementation
+bool RooksManager::setUp(bool turn, char positions[][3], int count){
+  if(count > 2){
+    return false;
+  }
+
+  for(int i = 0; i < 2; i++){
+    if(i < count){
+      rooks[turn][i] = Rook(positions[i]);
+    } else if(rooks[turn][i].getAlive()){
+      rooks[turn][i].setAlive();
+    }
+  }
+  return true;
+};
@@ -0,0 +1,65 @@
+/*
+ * RouteTable class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RouteTable.h"
+#include <stdlib.h>
+
+using namespace std;
+
+#ifndef ROUTE_TABLE_GENERATOR
+// Route implementation (the table does not exist yet while it is generated)
+int RouteTable::route(int fromX, int fromY, int toX, int toY, Waypoint path[]){
+  int bit = ((fromX + CEMETERY_COLUMNS) * 8 + fromY) * AREA_CELLS + (toX + CEMETERY_COLUMNS) * 8 + toY;
+
+  return route(fromX, fromY, toX, toY, path, (pgm_read_byte(&diagonalFirst[bit / 8]) >> (bit % 8)) & 1);
+};
+#endif
+
+int RouteTable::route(int fromX, int fromY, int toX, int toY, Waypoint path[], bool startDiagonal){
+  int dx = toX - fromX;
+  int dy = toY - fromY;
+  // number of cells crossed along the diagonal
+  int diagonal = abs(dx) < abs(dy) ? abs(dx) : abs(dy);
+  int signX = dx > 0 ? 1 : -1;
+  int signY = dy > 0 ? 1 : -1;
+  int numWaypoints = 0;
+
+  path[numWaypoints].x = fromX * STEPS;
+  path[numWaypoints].y = fromY * STEPS;
+  numWaypoints++;
+
+  // a route with two segments: the intermediate waypoint depends on which segment is performed first
+  if(diagonal > 0 && abs(dx) != abs(dy)){
+    if(startDiagonal){
+      path[numWaypoints].x = (fromX + signX * diagonal) * STEPS;
+      path[numWaypoints].y = (fromY + signY * diagonal) * STEPS;
+    } else {
+      path[numWaypoints].x = (toX - signX * diagonal) * STEPS;
+      path[numWaypoints].y = (toY - signY * diagonal) * STEPS;
+    }
+    numWaypoints++;
+  }
+
+  if(dx != 0 || dy != 0){
+    path[numWaypoints].x = toX * STEPS;
+    path[numWaypoints].y = toY * STEPS;
+    numWaypoints++;
+  }
+
+  return numWaypoints;
+};
@@ -0,0 +1,80 @@
+/*
+ * Header file for the RouteTable class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ROUTETABLE_H
+#define ROUTETABLE_H
+
+#include "PathPlanner.h"
+
+#ifdef ARDUINO
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_byte(address) (*(const unsigned char *)(address))
+#endif
+
+// Number of cells covered by the solenoid (chessboard and cemeteries)
+#define AREA_CELLS (AREA_COLUMNS * 8)
+
+class RouteTable {
+    public:
+        /**
+         * Find the fastest route between two cells when no other piece is on the way. On the empty chessboard
+         * the fastest route is made by a diagonal and a movement along an axis: the table generated by
+         * RouteTableGenerator (with the PathPlanner) keeps, with a bit for any pair of cells, which of the two
+         * is performed first.
+         * N.B.: the columns of the cells go from -CEMETERY_COLUMNS to 7 + CEMETERY_COLUMNS, as for the PathPlanner
+         *
+         * - Parameters :
+         *      - fromX : the column of the source cell
+         *      - fromY : the row of the source cell
+         *      - toX   : the column of the destination cell
+         *      - toY   : the row of the destination cell
+         *      - path  : the list (at least 3 long) filled with the waypoints of the route
+         *
+         * - Return : the number of waypoints of the route (1 if the source is the destination)
+         */
+        static int route(int fromX, int fromY, int toX, int toY, Waypoint path[]);
+
+        /**
+         * Build the route between two cells made by a diagonal and a movement along an axis
+         *
+         * - Parameters :
+         *      - fromX         : the column of the source cell
+         *      - fromY         : the row of the source cell
+         *      - toX           : the column of the destination cell
+         *      - toY           : the row of the destination cell
+         *      - path          : the list (at least 3 long) filled with the waypoints of the route
+         *      - startDiagonal : true to perform the diagonal before the movement along the axis
+         *
+         * - Return : the number of waypoints of the route (1 if the source is the destination)
+         */
+        static int route(int fromX, int fromY, int toX, int toY, Waypoint path[], bool startDiagonal);
+
+    private:
+        /**
+         * Private variables
+         *
+         * diagonalFirst : the bit (from * AREA_CELLS + to) is set if the route from the cell from to the cell to
+         *                 starts with the diagonal (the index of a cell is (column + CEMETERY_COLUMNS) * 8 + row).
+         *                 The table is stored in the flash memory
+         */
+        static const unsigned char diagonalFirst[AREA_CELLS * AREA_CELLS / 8] PROGMEM;
+};
+
+#endif
@@ -0,0 +1,94 @@
+/*
+ * RouteTable data, generated by RouteTableGenerator: do not edit.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RouteTable.h"
+
+const unsigned char RouteTable::diagonalFirst[AREA_CELLS * AREA_CELLS / 8] PROGMEM = {
+    0x00, 0x04, 0x3A, 0xF4, 0xEC, 0xDC, 0xB8, 0x78, 0xF8, 0xF0, 0xF0, 0xD0, 0x00, 0x08, 0x75, 0xE8,
+    0xD8, 0xB8, 0x70, 0xF0, 0xF0, 0xE0, 0x80, 0x80, 0x00, 0x11, 0xEA, 0xD3, 0xB1, 0x70, 0xE0, 0xE0,
+    0xA0, 0x80, 0x00, 0x00, 0x00, 0x22, 0xD5, 0xA6, 0x63, 0xE3, 0xC1, 0x80, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x44, 0xAB, 0x4D, 0xC6, 0xC7, 0x07, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x88, 0x57, 0x9B,
+    0x0D, 0x0E, 0x0F, 0x07, 0x07, 0x01, 0x01, 0x00, 0x00, 0x10, 0xAE, 0x37, 0x1B, 0x1D, 0x1E, 0x0F,
+    0x0F, 0x0F, 0x03, 0x01, 0x00, 0x20, 0x5C, 0x6F, 0x37, 0x3B, 0x3D, 0x1E, 0x1F, 0x1F, 0x0F, 0x0B,
+    0x04, 0x00, 0x04, 0x3A, 0xF4, 0xEC, 0xDC, 0xB8, 0x78, 0xF8, 0xF0, 0xF0, 0x08, 0x00, 0x08, 0x75,
+    0xE8, 0xD8, 0xB8, 0x70, 0xF0, 0xF0, 0xE0, 0x80, 0x11, 0x00, 0x11, 0xEA, 0xD3, 0xB1, 0x70, 0xE0,
+    0xE0, 0xA0, 0x80, 0x00, 0x22, 0x00, 0x22, 0xD5, 0xA6, 0x63, 0xE3, 0xC1, 0x80, 0x00, 0x00, 0x00,
+    0x44, 0x00, 0x44, 0xAB, 0x4D, 0xC6, 0xC7, 0x07, 0x01, 0x01, 0x00, 0x00, 0x88, 0x00, 0x88, 0x57,
+    0x9B, 0x0D, 0x0E, 0x0F, 0x07, 0x07, 0x01, 0x01, 0x10, 0x00, 0x10, 0xAE, 0x37, 0x1B, 0x1D, 0x1E,
+    0x0F, 0x0F, 0x0F, 0x03, 0x20, 0x00, 0x20, 0x5C, 0x6F, 0x37, 0x3B, 0x3D, 0x1E, 0x1F, 0x1F, 0x0F,
+    0x1A, 0x0C, 0x00, 0x04, 0x3A, 0xF4, 0xEC, 0xDC, 0xB8, 0x78, 0xF8, 0xF0, 0x35, 0x18, 0x00, 0x08,
+    0x75, 0xE8, 0xD8, 0xB8, 0x70, 0xF0, 0xF0, 0xE0, 0x6A, 0x31, 0x00, 0x11, 0xEA, 0xD3, 0xB1, 0x70,
+    0xE0, 0xE0, 0xA0, 0x80, 0xD5, 0x63, 0x00, 0x22, 0xD5, 0xA6, 0x63, 0xE3, 0xC1, 0x80, 0x00, 0x00,
+    0xAB, 0xC6, 0x00, 0x44, 0xAB, 0x4D, 0xC6, 0xC7, 0x07, 0x01, 0x01, 0x00, 0x56, 0x8C, 0x00, 0x88,
+    0x57, 0x9B, 0x0D, 0x0E, 0x0F, 0x07, 0x07, 0x01, 0xAC, 0x18, 0x00, 0x10, 0xAE, 0x37, 0x1B, 0x1D,
+    0x1E, 0x0F, 0x0F, 0x0F, 0x58, 0x30, 0x00, 0x20, 0x5C, 0x6F, 0x37, 0x3B, 0x3D, 0x1E, 0x1F, 0x1F,
+    0x74, 0x3A, 0x0C, 0x00, 0x04, 0x3A, 0xF4, 0xEC, 0xDC, 0xB8, 0x78, 0xF8, 0xE8, 0x75, 0x18, 0x00,
+    0x08, 0x75, 0xE8, 0xD8, 0xB8, 0x70, 0xF0, 0xF0, 0xD3, 0xEA, 0x31, 0x00, 0x11, 0xEA, 0xD3, 0xB1,
+    0x70, 0xE0, 0xE0, 0xA0, 0xA6, 0xD5, 0x63, 0x00, 0x22, 0xD5, 0xA6, 0x63, 0xE3, 0xC1, 0x80, 0x00,
+    0x4D, 0xAB, 0xC6, 0x00, 0x44, 0xAB, 0x4D, 0xC6, 0xC7, 0x07, 0x01, 0x01, 0x9B, 0x57, 0x8C, 0x00,
+    0x88, 0x57, 0x9B, 0x0D, 0x0E, 0x0F, 0x07, 0x07, 0x37, 0xAE, 0x18, 0x00, 0x10, 0xAE, 0x37, 0x1B,
+    0x1D, 0x1E, 0x0F, 0x0F, 0x6E, 0x5C, 0x30, 0x00, 0x20, 0x5C, 0x6F, 0x37, 0x3B, 0x3D, 0x1E, 0x1F,
+    0xEC, 0x74, 0x7A, 0x0C, 0x00, 0x04, 0x3A, 0xF4, 0xEC, 0xDC, 0xB8, 0x78, 0xD8, 0xE8, 0xF5, 0x18,
+    0x00, 0x08, 0x75, 0xE8, 0xD8, 0xB8, 0x70, 0xF0, 0xB1, 0xD3, 0xEA, 0x31, 0x00, 0x11, 0xEA, 0xD3,
+    0xB1, 0x70, 0xE0, 0xE0, 0x63, 0xA6, 0xD5, 0x63, 0x00, 0x22, 0xD5, 0xA6, 0x63, 0xE3, 0xC1, 0x80,
+    0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x44, 0xAB, 0x4D, 0xC6, 0xC7, 0x07, 0x01, 0x0D, 0x9B, 0x57, 0x8C,
+    0x00, 0x88, 0x57, 0x9B, 0x0D, 0x0E, 0x0F, 0x07, 0x1B, 0x37, 0xAF, 0x18, 0x00, 0x10, 0xAE, 0x37,
+    0x1B, 0x1D, 0x1E, 0x0F, 0x37, 0x6E, 0x5E, 0x30, 0x00, 0x20, 0x5C, 0x6F, 0x37, 0x3B, 0x3D, 0x1E,
+    0xDC, 0xEC, 0xF4, 0x7A, 0x0C, 0x00, 0x04, 0x3A, 0xF4, 0xEC, 0xDC, 0xB8, 0xB8, 0xD8, 0xE8, 0xF5,
+    0x18, 0x00, 0x08, 0x75, 0xE8, 0xD8, 0xB8, 0x70, 0x70, 0xB1, 0xD3, 0xEA, 0x31, 0x00, 0x11, 0xEA,
+    0xD3, 0xB1, 0x70, 0xE0, 0xE3, 0x63, 0xA6, 0xD5, 0x63, 0x00, 0x22, 0xD5, 0xA6, 0x63, 0xE3, 0xC1,
+    0xC7, 0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x44, 0xAB, 0x4D, 0xC6, 0xC7, 0x07, 0x0E, 0x0D, 0x9B, 0x57,
+    0x8C, 0x00, 0x88, 0x57, 0x9B, 0x0D, 0x0E, 0x0F, 0x1D, 0x1B, 0x37, 0xAF, 0x18, 0x00, 0x10, 0xAE,
+    0x37, 0x1B, 0x1D, 0x1E, 0x3B, 0x37, 0x6F, 0x5E, 0x30, 0x00, 0x20, 0x5C, 0x6F, 0x37, 0x3B, 0x3D,
+    0xB8, 0xDC, 0xEC, 0xF4, 0x7A, 0x0C, 0x00, 0x04, 0x3A, 0xF4, 0xEC, 0xDC, 0x70, 0xB8, 0xD8, 0xE8,
+    0xF5, 0x18, 0x00, 0x08, 0x75, 0xE8, 0xD8, 0xB8, 0xE0, 0x70, 0xB1, 0xD3, 0xEA, 0x31, 0x00, 0x11,
+    0xEA, 0xD3, 0xB1, 0x70, 0xC1, 0xE3, 0x63, 0xA6, 0xD5, 0x63, 0x00, 0x22, 0xD5, 0xA6, 0x63, 0xE3,
+    0x07, 0xC7, 0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x44, 0xAB, 0x4D, 0xC6, 0xC7, 0x0F, 0x0E, 0x0D, 0x9B,
+    0x57, 0x8C, 0x00, 0x88, 0x57, 0x9B, 0x0D, 0x0E, 0x1E, 0x1D, 0x1B, 0x37, 0xAF, 0x18, 0x00, 0x10,
+    0xAE, 0x37, 0x1B, 0x1D, 0x3D, 0x3B, 0x37, 0x6F, 0x5E, 0x30, 0x00, 0x20, 0x5C, 0x6F, 0x37, 0x3B,
+    0x78, 0xB8, 0xDC, 0xEC, 0xF4, 0x7A, 0x0C, 0x00, 0x04, 0x3A, 0x74, 0xEC, 0xF0, 0x70, 0xB8, 0xD8,
+    0xE8, 0xF5, 0x18, 0x00, 0x08, 0x75, 0xE8, 0xD8, 0xE0, 0xE0, 0x70, 0xB1, 0xD3, 0xEA, 0x31, 0x00,
+    0x11, 0xEA, 0xD3, 0xB1, 0x80, 0xC1, 0xE3, 0x63, 0xA6, 0xD5, 0x63, 0x00, 0x22, 0xD5, 0xA6, 0x63,
+    0x01, 0x07, 0xC7, 0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x44, 0xAB, 0x4D, 0xC6, 0x07, 0x0F, 0x0E, 0x0D,
+    0x9B, 0x57, 0x8C, 0x00, 0x88, 0x57, 0x9B, 0x0D, 0x0F, 0x1E, 0x1D, 0x1B, 0x37, 0xAF, 0x18, 0x00,
+    0x10, 0xAE, 0x37, 0x1B, 0x1E, 0x3D, 0x3B, 0x37, 0x6F, 0x5E, 0x30, 0x00, 0x20, 0x5C, 0x6E, 0x37,
+    0xF8, 0x78, 0xB8, 0xDC, 0xEC, 0xF4, 0x7A, 0x0C, 0x00, 0x04, 0x3A, 0x34, 0xF0, 0xF0, 0x70, 0xB8,
+    0xD8, 0xE8, 0xF5, 0x18, 0x00, 0x08, 0x75, 0x68, 0xA0, 0xE0, 0xE0, 0x70, 0xB1, 0xD3, 0xEA, 0x31,
+    0x00, 0x11, 0xEA, 0xD3, 0x00, 0x80, 0xC1, 0xE3, 0x63, 0xA6, 0xD5, 0x63, 0x00, 0x22, 0xD5, 0xA6,
+    0x01, 0x01, 0x07, 0xC7, 0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x44, 0xAB, 0x4D, 0x07, 0x07, 0x0F, 0x0E,
+    0x0D, 0x9B, 0x57, 0x8C, 0x00, 0x88, 0x57, 0x9B, 0x0F, 0x0F, 0x1E, 0x1D, 0x1B, 0x37, 0xAF, 0x18,
+    0x00, 0x10, 0xAE, 0x36, 0x1F, 0x1E, 0x3D, 0x3B, 0x37, 0x6F, 0x5E, 0x30, 0x00, 0x20, 0x5C, 0x6C,
+    0xF0, 0xF8, 0x78, 0xB8, 0xDC, 0xEC, 0xF4, 0x7A, 0x0C, 0x00, 0x04, 0x0A, 0xE0, 0xF0, 0xF0, 0x70,
+    0xB8, 0xD8, 0xE8, 0xF5, 0x18, 0x00, 0x08, 0x15, 0x80, 0xA0, 0xE0, 0xE0, 0x70, 0xB1, 0xD3, 0xEA,
+    0x31, 0x00, 0x11, 0x2A, 0x00, 0x00, 0x80, 0xC1, 0xE3, 0x63, 0xA6, 0xD5, 0x63, 0x00, 0x22, 0x55,
+    0x00, 0x01, 0x01, 0x07, 0xC7, 0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x44, 0xAA, 0x01, 0x07, 0x07, 0x0F,
+    0x0E, 0x0D, 0x9B, 0x57, 0x8C, 0x00, 0x88, 0x54, 0x0F, 0x0F, 0x0F, 0x1E, 0x1D, 0x1B, 0x37, 0xAF,
+    0x18, 0x00, 0x10, 0xA8, 0x1F, 0x1F, 0x1E, 0x3D, 0x3B, 0x37, 0x6F, 0x5E, 0x30, 0x00, 0x20, 0x50,
+    0xF0, 0xF0, 0xF8, 0x78, 0xB8, 0xDC, 0xEC, 0xF4, 0x7A, 0x0C, 0x00, 0x04, 0x80, 0xE0, 0xF0, 0xF0,
+    0x70, 0xB8, 0xD8, 0xE8, 0xF5, 0x18, 0x00, 0x08, 0x00, 0x80, 0xA0, 0xE0, 0xE0, 0x70, 0xB1, 0xD3,
+    0xEA, 0x31, 0x00, 0x11, 0x00, 0x00, 0x00, 0x80, 0xC1, 0xE3, 0x63, 0xA6, 0xD5, 0x63, 0x00, 0x22,
+    0x00, 0x00, 0x01, 0x01, 0x07, 0xC7, 0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x44, 0x01, 0x01, 0x07, 0x07,
+    0x0F, 0x0E, 0x0D, 0x9B, 0x57, 0x8C, 0x00, 0x88, 0x03, 0x0F, 0x0F, 0x0F, 0x1E, 0x1D, 0x1B, 0x37,
+    0xAF, 0x18, 0x00, 0x10, 0x0F, 0x1F, 0x1F, 0x1E, 0x3D, 0x3B, 0x37, 0x6F, 0x5E, 0x30, 0x00, 0x20,
+    0xD0, 0xF0, 0xF0, 0xF8, 0x78, 0xB8, 0xDC, 0xEC, 0xF4, 0x7A, 0x0C, 0x00, 0x80, 0x80, 0xE0, 0xF0,
+    0xF0, 0x70, 0xB8, 0xD8, 0xE8, 0xF5, 0x18, 0x00, 0x00, 0x00, 0x80, 0xA0, 0xE0, 0xE0, 0x70, 0xB1,
+    0xD3, 0xEA, 0x31, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0xC1, 0xE3, 0x63, 0xA6, 0xD5, 0x63, 0x00,
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x07, 0xC7, 0xC6, 0x4D, 0xAB, 0xC6, 0x00, 0x00, 0x01, 0x01, 0x07,
+    0x07, 0x0F, 0x0E, 0x0D, 0x9B, 0x57, 0x8C, 0x00, 0x01, 0x03, 0x0F, 0x0F, 0x0F, 0x1E, 0x1D, 0x1B,
+    0x37, 0xAF, 0x18, 0x00, 0x0B, 0x0F, 0x1F, 0x1F, 0x1E, 0x3D, 0x3B, 0x37, 0x6F, 0x5E, 0x30, 0x00
+};
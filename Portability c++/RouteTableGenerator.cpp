@@ -0,0 +1,95 @@
+/*
+ * Generator of the RouteTable data (RouteTableData.cpp)
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The generator plans with the PathPlanner the route between any pair of cells of the empty chessboard (and
+ * cemeteries) and prints the RouteTableData.cpp file on the standard output. It is built and executed by the
+ * project Makefile any time the PathPlanner changes:
+ *
+ *      make RouteTableData.cpp
+ *
+ * N.B.: the PathPlanner must be compiled with ROUTE_TABLE_GENERATOR defined, so that it does not look for
+ *       the routes in the table that is being generated
+ */
+
+#include "PathPlanner.h"
+#include "RouteTable.h"
+#include <stdio.h>
+
+using namespace std;
+
+int main(){
+  PathPlanner pathPlanner;
+  Waypoint path[MAX_WAYPOINTS];
+  Waypoint cached[3];
+  unsigned char diagonalFirst[AREA_CELLS * AREA_CELLS / 8] = {0};
+
+  // plan any route on the empty chessboard (the PathPlanner starts without obstacles)
+  for(int from = 0; from < AREA_CELLS; from++){
+    for(int to = 0; to < AREA_CELLS; to++){
+      int bit = from * AREA_CELLS + to;
+      int numWaypoints = pathPlanner.plan(from / 8 - CEMETERY_COLUMNS, from % 8, to / 8 - CEMETERY_COLUMNS, to % 8, path);
+      if(numWaypoints > 3){
+        fprintf(stderr, "Unexpected route from %d to %d\n", from, to);
+        return 1;
+      }
+      // the route starts with the diagonal if both the coordinates change in the first segment
+      // (a route through the edges of the cells is replaced by the equivalent one through the centers)
+      if(numWaypoints == 3 && path[1].x != path[0].x && path[1].y != path[0].y){
+        diagonalFirst[bit / 8] |= 1 << (bit % 8);
+      }
+
+      // the table must keep routes as fast as the ones of the PathPlanner
+      int numCached = RouteTable::route(from / 8 - CEMETERY_COLUMNS, from % 8, to / 8 - CEMETERY_COLUMNS, to % 8,
+                                        cached, (diagonalFirst[bit / 8] >> (bit % 8)) & 1);
+      if(PathPlanner::routeTime(cached, numCached) != PathPlanner::routeTime(path, numWaypoints)){
+        fprintf(stderr, "Slower route from %d to %d\n", from, to);
+        return 1;
+      }
+    }
+  }
+
+  printf("/*\n");
+  printf(" * RouteTable data, generated by RouteTableGenerator: do not edit.\n");
+  printf(" *\n");
+  printf(" * Copyright (c) 2018 Davide Molinelli.\n");
+  printf(" *\n");
+  printf(" * This program is free software: you can redistribute it and/or modify\n");
+  printf(" * it under the terms of the GNU General Public License as published by\n");
+  printf(" * the Free Software Foundation, version 3.\n");
+  printf(" *\n");
+  printf(" * This program is distributed in the hope that it will be useful, but\n");
+  printf(" * WITHOUT ANY WARRANTY; without even the implied warranty of\n");
+  printf(" * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU\n");
+  printf(" * General Public License for more details.\n");
+  printf(" *\n");
+  printf(" * You should have received a copy of the GNU General Public License\n");
+  printf(" * along with this program. If not, see <http://www.gnu.org/licenses/>.\n");
+  printf(" */\n\n");
+  printf("#include \"RouteTable.h\"\n\n");
+  printf("const unsigned char RouteTable::diagonalFirst[AREA_CELLS * AREA_CELLS / 8] PROGMEM = {");
+  for(int i = 0; i < AREA_CELLS * AREA_CELLS / 8; i++){
+    printf("%s0x%02X", i % 16 == 0 ? "\n    " : " ", diagonalFirst[i]);
+    if(i < AREA_CELLS * AREA_CELLS / 8 - 1){
+      printf(",");
+    }
+  }
+  printf("\n};\n");
+
+  return 0;
+}
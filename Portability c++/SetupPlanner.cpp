@@ -0,0 +1,344 @@
+/*
+ * SetupPlanner class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SetupPlanner.h"
+#include "PathPlanner.h"
+#include "RouteTable.h"
+#include "Config.h"
+#include <stdlib.h>
+
+using namespace std;
+
+// Cost greater than any assignment
+#define INFINITE_COST 0x7FFFFFFFL
+
+// Constructor
+SetupPlanner::SetupPlanner(){
+  numPending = 0;
+};
+
+// Plan implementation
+int SetupPlanner::plan(Cell * cbState[][8], CemeteryManager cemeteryState, char targetColors[][8], char targetPieces[][8],
+                       long x, long y, Transfer transfers[]){
+  const char types[6] = {'P', 'R', 'B', 'H', 'Q', 'K'};
+  int numTransfers = 0;
+
+  cemetery = cemeteryState;
+  numPending = 0;
+  for(int i = 0; i < 8; i++){
+    busy[i] = 0;
+    for(int j = 0; j < 8; j++){
+      if(cbState[i][j]->getBusy()){
+        busy[i] |= 1 << j;
+      }
+    }
+  }
+
+  // the pieces of the same color and type are interchangeable: any group is assigned on its own
+  for(int color = WHITE; color <= BLACK; color++){
+    for(int i = 0; i < 6; i++){
+      if(!assignGroup(cbState, targetColors, targetPieces, color, types[i])){
+        return -1;
+      }
+    }
+  }
+
+  while(numPending > 0){
+    int next = -1;
+    long nextDistance = 0;
+
+    // the next piece is the nearest to the solenoid among the ones that can reach their cell: a piece can go
+    // to the cemetery any time, to a cell of the chessboard only when the cell is free
+    for(int i = 0; i < numPending; i++){
+      if(pending[i].toY >= 0 && ((busy[pending[i].toX] >> pending[i].toY) & 1)){
+        continue;
+      }
+      long distance = labs(pending[i].fromX * (long) STEPS - x) > labs(pending[i].fromY * (long) STEPS - y) ?
+                      labs(pending[i].fromX * (long) STEPS - x) : labs(pending[i].fromY * (long) STEPS - y);
+      if(next < 0 || distance < nextDistance){
+        next = i;
+        nextDistance = distance;
+      }
+    }
+
+    if(numTransfers == MAX_TRANSFERS){
+      return -1;
+    }
+
+    if(next < 0){
+      // any piece waits for the cell of another piece that is waiting too: following the pieces that hold the
+      // cells for numPending times surely ends on a cycle, that is broken by parking that piece
+      next = 0;
+      for(int i = 0; i < numPending; i++){
+        int holder = -1;
+        for(int j = 0; j < numPending && holder < 0; j++){
+          if(pending[j].fromX == pending[next].toX && pending[j].fromY == pending[next].toY){
+            holder = j;
+          }
+        }
+        if(holder < 0){
+          return -1;
+        }
+        next = holder;
+      }
+
+      // the parking cell is a free cell of the chessboard that no piece needs (there are always at least 32)
+      int parkX = -1;
+      int parkY = -1;
+      long parkTime = 0;
+      for(int i = 0; i < 8; i++){
+        for(int j = 0; j < 8; j++){
+          bool taken = (busy[i] >> j) & 1;
+          for(int k = 0; k < numPending && !taken; k++){
+            taken = pending[k].toX == i && pending[k].toY == j;
+          }
+          if(taken){
+            continue;
+          }
+          long time = travelTime(pending[next].fromX, pending[next].fromY, i, j) +
+                      travelTime(i, j, pending[next].toX, pending[next].toY);
+          if(parkX < 0 || time < parkTime){
+            parkX = i;
+            parkY = j;
+            parkTime = time;
+          }
+        }
+      }
+      if(parkX < 0){
+        return -1;
+      }
+
+      transfers[numTransfers] = pending[next];
+      transfers[numTransfers].toX = parkX;
+      transfers[numTransfers].toY = parkY;
+      numTransfers++;
+      busy[pending[next].fromX] &= ~(1 << pending[next].fromY);
+      busy[parkX] |= 1 << parkY;
+      x = parkX * (long) STEPS;
+      y = parkY * (long) STEPS;
+
+      // the piece will reach its cell from the parking cell
+      pending[next].fromX = parkX;
+      pending[next].fromY = parkY;
+      continue;
+    }
+
+    bool color = pending[next].color == 'B' ? BLACK : WHITE;
+
+    if(pending[next].toY < 0){
+      int slotX;
+      int slotY;
+      long time;
+      int slot = nearestSpace(color, pending[next].piece, pending[next].fromX, pending[next].fromY, &time);
+      if(slot < 0){
+        return -1;
+      }
+      PathPlanner::cemeteryCell(color, slot, &slotX, &slotY);
+      cemetery.place(color, slot, pending[next].piece);
+      pending[next].toX = slotX;
+      pending[next].toY = slotY;
+    } else {
+      busy[pending[next].toX] |= 1 << pending[next].toY;
+    }
+
+    if(pending[next].fromX < 0 || pending[next].fromX > 7){
+      cemetery.remove(color, PathPlanner::cemeterySlot(pending[next].fromX, pending[next].fromY));
+    } else {
+      busy[pending[next].fromX] &= ~(1 << pending[next].fromY);
+    }
+
+    transfers[numTransfers] = pending[next];
+    numTransfers++;
+    x = pending[next].toX * (long) STEPS;
+    y = pending[next].toY * (long) STEPS;
+    pending[next] = pending[numPending - 1];
+    numPending--;
+  }
+
+  return numTransfers;
+};
+
+// Assign implementation (Hungarian algorithm with potentials, rows and columns counted from 1)
+void SetupPlanner::assign(long cost[][MAX_GROUP], int size, int assignment[]){
+  long u[MAX_GROUP + 1];
+  long v[MAX_GROUP + 1];
+  // row assigned to any column (0 = none) and previous column on the augmenting path
+  int rowOf[MAX_GROUP + 1];
+  int way[MAX_GROUP + 1];
+  long minCost[MAX_GROUP + 1];
+  bool used[MAX_GROUP + 1];
+
+  for(int j = 0; j <= size; j++){
+    u[j] = 0;
+    v[j] = 0;
+    rowOf[j] = 0;
+    way[j] = 0;
+  }
+
+  for(int i = 1; i <= size; i++){
+    // the new row starts from the fictitious column 0
+    rowOf[0] = i;
+    int column = 0;
+    for(int j = 0; j <= size; j++){
+      minCost[j] = INFINITE_COST;
+      used[j] = false;
+    }
+
+    // grow the alternating tree until a free column is reached
+    do {
+      used[column] = true;
+      int row = rowOf[column];
+      int nextColumn = 0;
+      long delta = INFINITE_COST;
+      for(int j = 1; j <= size; j++){
+        if(used[j]){
+          continue;
+        }
+        long reduced = cost[row - 1][j - 1] - u[row] - v[j];
+        if(reduced < minCost[j]){
+          minCost[j] = reduced;
+          way[j] = column;
+        }
+        if(minCost[j] < delta){
+          delta = minCost[j];
+          nextColumn = j;
+        }
+      }
+      for(int j = 0; j <= size; j++){
+        if(used[j]){
+          u[rowOf[j]] += delta;
+          v[j] -= delta;
+        } else {
+          minCost[j] -= delta;
+        }
+      }
+      column = nextColumn;
+    } while(rowOf[column] != 0);
+
+    // flip the augmenting path
+    do {
+      int previous = way[column];
+      rowOf[column] = rowOf[previous];
+      column = previous;
+    } while(column != 0);
+  }
+
+  for(int j = 1; j <= size; j++){
+    assignment[rowOf[j] - 1] = j - 1;
+  }
+};
+
+bool SetupPlanner::assignGroup(Cell * cbState[][8], char targetColors[][8], char targetPieces[][8], bool color, char piece){
+  char colorChar = color == WHITE ? 'W' : 'B';
+  int sourceX[MAX_GROUP];
+  int sourceY[MAX_GROUP];
+  int targetX[MAX_GROUP];
+  int targetY[MAX_GROUP];
+  int numSources = 0;
+  int numTargets = 0;
+  long cost[MAX_GROUP][MAX_GROUP];
+  int assignment[MAX_GROUP];
+
+  for(int i = 0; i < 8; i++){
+    for(int j = 0; j < 8; j++){
+      if(cbState[i][j]->getBusy() && cbState[i][j]->getColor() == colorChar && cbState[i][j]->getPiece() == piece &&
+         numSources < MAX_GROUP){
+        sourceX[numSources] = i;
+        sourceY[numSources] = j;
+        numSources++;
+      }
+      if(targetColors[i][j] == colorChar && targetPieces[i][j] == piece){
+        if(numTargets == MAX_GROUP){
+          return false;
+        }
+        targetX[numTargets] = i;
+        targetY[numTargets] = j;
+        numTargets++;
+      }
+    }
+  }
+  for(int slot = 0; slot < CEMETERY_SLOTS && numSources < MAX_GROUP; slot++){
+    if(((cemetery.getOccupancy(color) >> slot) & 1) && cemetery.getPiece(color, slot) == piece){
+      PathPlanner::cemeteryCell(color, slot, &sourceX[numSources], &sourceY[numSources]);
+      numSources++;
+    }
+  }
+
+  // the extra pieces go to the cemetery, so there are not enough pieces only if some target cell stays empty
+  if(numTargets > numSources){
+    return false;
+  }
+
+  // the columns after the target cells stand for the cemetery: a piece already there stays for free
+  for(int i = 0; i < numSources; i++){
+    long cemeteryTime = 0;
+    if(sourceX[i] >= 0 && sourceX[i] <= 7 && nearestSpace(color, piece, sourceX[i], sourceY[i], &cemeteryTime) < 0){
+      cemeteryTime = INFINITE_COST / 2;
+    }
+    for(int j = 0; j < numSources; j++){
+      if(j < numTargets){
+        cost[i][j] = travelTime(sourceX[i], sourceY[i], targetX[j], targetY[j]);
+      } else {
+        cost[i][j] = cemeteryTime;
+      }
+    }
+  }
+  assign(cost, numSources, assignment);
+
+  for(int i = 0; i < numSources; i++){
+    int j = assignment[i];
+    bool onBoard = sourceX[i] >= 0 && sourceX[i] <= 7;
+    if((j < numTargets && (sourceX[i] != targetX[j] || sourceY[i] != targetY[j])) || (j >= numTargets && onBoard)){
+      pending[numPending].fromX = sourceX[i];
+      pending[numPending].fromY = sourceY[i];
+      // the space of the cemetery is chosen when the transfer is ordered
+      pending[numPending].toX = j < numTargets ? targetX[j] : 0;
+      pending[numPending].toY = j < numTargets ? targetY[j] : -1;
+      pending[numPending].color = colorChar;
+      pending[numPending].piece = piece;
+      numPending++;
+    }
+  }
+  return true;
+};
+
+int SetupPlanner::nearestSpace(bool color, char piece, int x, int y, long * time){
+  unsigned short candidates = cemetery.getCandidates(color, piece);
+  int slot = -1;
+
+  for(int i = 0; i < CEMETERY_SLOTS; i++){
+    int slotX;
+    int slotY;
+    if(!((candidates >> i) & 1)){
+      continue;
+    }
+    PathPlanner::cemeteryCell(color, i, &slotX, &slotY);
+    long spaceTime = travelTime(x, y, slotX, slotY);
+    if(slot < 0 || spaceTime < *time){
+      slot = i;
+      *time = spaceTime;
+    }
+  }
+  return slot;
+};
+
+long SetupPlanner::travelTime(int fromX, int fromY, int toX, int toY){
+  Waypoint path[3];
+
+  return PathPlanner::routeTime(path, RouteTable::route(fromX, fromY, toX, toY, path));
+};
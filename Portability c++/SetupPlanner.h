@@ -0,0 +1,149 @@
+/*
+ * Header file for the SetupPlanner class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SETUPPLANNER_H
+#define SETUPPLANNER_H
+
+#include "Cell.h"
+#include "CemeteryManager.h"
+
+// Maximum number of pieces of a color of the same type (the pawns)
+#define MAX_GROUP 8
+
+// Maximum number of transfers of a setup: one for any piece plus one for any cycle of pieces that must be broken
+#define MAX_TRANSFERS 48
+
+/**
+ * Transfer variables
+ *
+ * fromX : the column of the source cell (negative or greater than 7 for a cemetery)
+ * fromY : the row of the source cell
+ * toX   : the column of the destination cell (negative or greater than 7 for a cemetery)
+ * toY   : the row of the destination cell
+ * color : the color of the transferred piece ('W' or 'B')
+ * piece : the type of the transferred piece
+ */
+struct Transfer {
+    signed char fromX;
+    signed char fromY;
+    signed char toX;
+    signed char toY;
+    char color;
+    char piece;
+};
+
+class SetupPlanner {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class
+         */
+        SetupPlanner();
+
+        /**
+         * Plan the transfers that take the pieces from their current cells (on the chessboard and in the
+         * cemeteries) to a target position:
+         *  1. For any color and type, the pieces are assigned to the target cells (the extra ones to the
+         *     cemetery) minimizing the total travel time on the empty chessboard (Hungarian algorithm)
+         *  2. The transfers are ordered so that any piece goes to a free cell, starting any time from the
+         *     piece nearest to the solenoid; a cycle of pieces waiting for each other's cell is broken by
+         *     parking one of them on a free cell that no piece needs
+         * N.B.: the cemetery spaces of the pieces that leave the chessboard are chosen during the ordering
+         *
+         * - Parameters :
+         *      - cbState      : indicates the position of all the pieces on the chessboard
+         *      - cemetery     : the current state of the cemeteries (a copy, updated by the planning)
+         *      - targetColors : the color ('W', 'B' or 'E') of the piece wanted on any cell of the chessboard
+         *      - targetPieces : the type of the piece wanted on any cell of the chessboard
+         *      - x            : the position of the solenoid along the X axis (steps from the center of A1)
+         *      - y            : the position of the solenoid along the Y axis (steps from the center of A1)
+         *      - transfers    : the list (at least MAX_TRANSFERS long) filled with the ordered transfers
+         *
+         * - Return : the number of transfers, -1 if the target position needs more pieces than the existing ones
+         */
+        int plan(Cell * cbState[][8], CemeteryManager cemetery, char targetColors[][8], char targetPieces[][8],
+                 long x, long y, Transfer transfers[]);
+
+        /**
+         * Solve the assignment problem with the Hungarian algorithm in O(size^3)
+         *
+         * - Parameters :
+         *      - cost       : the cost of assigning the row i to the column j
+         *      - size       : the number of rows and columns of the matrix
+         *      - assignment : filled with the column assigned to any row (the total cost is minimum)
+         */
+        static void assign(long cost[][MAX_GROUP], int size, int assignment[]);
+
+    private:
+        /**
+         * Estimate the time needed to carry a piece between two cells when no other piece is on the way
+         *
+         * - Parameters :
+         *      - fromX : the column of the source cell
+         *      - fromY : the row of the source cell
+         *      - toX   : the column of the destination cell
+         *      - toY   : the row of the destination cell
+         *
+         * - Return : the travel time (ms)
+         */
+        static long travelTime(int fromX, int fromY, int toX, int toY);
+
+        /**
+         * Find the free cemetery space where a piece leaving the chessboard arrives first
+         *
+         * - Parameters :
+         *      - color : the color of the piece (WHITE or BLACK)
+         *      - piece : the type of the piece
+         *      - x     : the column of the cell of the piece
+         *      - y     : the row of the cell of the piece
+         *      - time  : filled with the travel time to the space
+         *
+         * - Return : the index of the space (0 - 15), -1 if the cemetery is full
+         */
+        int nearestSpace(bool color, char piece, int x, int y, long * time);
+
+        /**
+         * Collect the transfers of the pieces of a color and type, assigning them to the target cells
+         *
+         * - Parameters :
+         *      - cbState      : indicates the position of all the pieces on the chessboard
+         *      - targetColors : the color of the piece wanted on any cell of the chessboard
+         *      - targetPieces : the type of the piece wanted on any cell of the chessboard
+         *      - color        : the color of the pieces (WHITE or BLACK)
+         *      - piece        : the type of the pieces
+         *
+         * - Return : false if the target position needs more pieces of the type than the existing ones
+         */
+        bool assignGroup(Cell * cbState[][8], char targetColors[][8], char targetPieces[][8], bool color, char piece);
+
+        /**
+         * Private variables
+         *
+         * cemetery   : the state of the cemeteries while the transfers are ordered
+         * busy       : for any column of the chessboard, the bit y is set if the cell in the row y is busy
+         * pending    : the transfers not ordered yet (the ones toward a cemetery have a negative toY)
+         * numPending : the number of transfers not ordered yet
+         */
+        CemeteryManager cemetery;
+        unsigned char busy[8];
+        Transfer pending[MAX_TRANSFERS];
+        int numPending;
+};
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ * SimulatedTimer class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SimulatedTimer.h"
+
+using namespace std;
+
+// Constructor
+SimulatedTimer::SimulatedTimer(){
+  deadline = 0;
+  stopped = false;
+  jitter = 0;
+  underruns = 0;
+};
+
+bool SimulatedTimer::fire(StepScheduler * scheduler, Simulator * clock){
+  if(scheduler->idle()){
+    return false;
+  }
+  unsigned long now = clock->micros();
+  if(stopped){
+    // the timer has been restarted by a new edge: the edge should have been applied when the ring ran empty
+    stopped = false;
+    underruns++;
+    if(now - deadline > jitter){
+      jitter = now - deadline;
+    }
+  }
+
+  unsigned long interval = scheduler->interrupt();
+  if(interval == 0){
+    stopped = true;
+    deadline = now;
+    return false;
+  }
+  deadline = now + interval;
+  clock->delayMicroseconds(interval);
+  return true;
+};
+
+void SimulatedTimer::advance(StepScheduler * scheduler, Simulator * clock, unsigned long until){
+  // after a fire the virtual clock is at the compare match of the next edge
+  while(clock->micros() <= until && fire(scheduler, clock));
+  if(clock->micros() < until){
+    clock->delayMicroseconds(until - clock->micros());
+  }
+};
+
+unsigned long SimulatedTimer::getJitter(){
+  return jitter;
+};
+
+int SimulatedTimer::getUnderruns(){
+  return underruns;
+};
+
+void SimulatedTimer::reset(){
+  stopped = false;
+  jitter = 0;
+  underruns = 0;
+};
@@ -0,0 +1,94 @@
+/*
+ * Header file for the SimulatedTimer class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMULATEDTIMER_H
+#define SIMULATEDTIMER_H
+
+#include "Config.h"
+#include "Simulator.h"
+#include "StepScheduler.h"
+
+class SimulatedTimer {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with the timer stopped and no jitter measured
+         */
+        SimulatedTimer();
+
+        /**
+         * Fire the timer interrupt of the step scheduler at its compare match: the virtual clock is advanced by
+         * the programmed interval. The compare matches are spaced by the intervals, so an edge is late only if
+         * the ring has run empty (an underrun) and the timer has been restarted after its deadline
+         *
+         * - Parameters :
+         *      - scheduler : the step scheduler that owns the interrupt
+         *      - clock     : the virtual clock of the board
+         *
+         * - Return : false if the timer is stopped (there are no more edges)
+         */
+        bool fire(StepScheduler * scheduler, Simulator * clock);
+
+        /**
+         * Fire the interrupts whose compare match comes before a time, as the board does while the producer of
+         * the edges is late: if the ring runs empty the virtual clock still reaches the time
+         *
+         * - Parameters :
+         *      - scheduler : the step scheduler that owns the interrupt
+         *      - clock     : the virtual clock of the board
+         *      - until     : the virtual time (us) reached
+         */
+        void advance(StepScheduler * scheduler, Simulator * clock, unsigned long until);
+
+        /**
+         * Get the jitter of the step pulses: the largest delay between the deadline of an edge (the deadline of
+         * the previous edge plus its interval) and the virtual time when the edge has been applied
+         *
+         * - Return : the jitter (us) since the last reset
+         */
+        unsigned long getJitter();
+
+        /**
+         * Get the number of underruns: the times that the ring has run empty and the timer has been restarted
+         *
+         * - Return : the number of underruns since the last reset
+         */
+        int getUnderruns();
+
+        /**
+         * Start a new measurement (es: at the end of a sequence, where the timer stops as expected)
+         */
+        void reset();
+
+    private:
+        /**
+         * Private variables
+         *
+         * deadline  : the virtual time (us) of the compare match of the next edge
+         * stopped   : indicates if the timer has been stopped by an empty ring since the last reset
+         * jitter    : the largest delay of an edge since the last reset
+         * underruns : the number of underruns since the last reset
+         */
+        unsigned long deadline;
+        bool stopped;
+        unsigned long jitter;
+        int underruns;
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ * Simulator class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Simulator.h"
+
+using namespace std;
+
+// Constructor
+Simulator::Simulator(){
+  clock = 0;
+};
+
+void Simulator::delay(unsigned long ms){
+  clock += ms * 1000;
+};
+
+void Simulator::delayMicroseconds(unsigned long us){
+  clock += us;
+};
+
+unsigned long Simulator::millis(){
+  return clock / 1000;
+};
+
+unsigned long Simulator::micros(){
+  return clock;
+};
@@ -0,0 +1,70 @@
+/*
+ * Header file for the Simulator class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+class Simulator {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with the clock set to 0
+         */
+        Simulator();
+
+        /**
+         * Advance the virtual clock as the Arduino delay function would do
+         *
+         * - Parameters :
+         *      - ms : the number of milliseconds to wait
+         */
+        void delay(unsigned long ms);
+
+        /**
+         * Advance the virtual clock as the Arduino delayMicroseconds function would do
+         *
+         * - Parameters :
+         *      - us : the number of microseconds to wait
+         */
+        void delayMicroseconds(unsigned long us);
+
+        /**
+         * Read the virtual clock as the Arduino millis function would do
+         *
+         * - Return : the number of milliseconds elapsed since the creation of the simulator
+         */
+        unsigned long millis();
+
+        /**
+         * Read the virtual clock as the Arduino micros function would do
+         *
+         * - Return : the number of microseconds elapsed since the creation of the simulator
+         */
+        unsigned long micros();
+
+    private:
+        /**
+         * Private variables
+         *
+         * clock : the virtual time elapsed, expressed in microseconds
+         */
+        unsigned long clock;
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * StepScheduler class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StepScheduler.h"
+
+using namespace std;
+
+// Constructor
+StepScheduler::StepScheduler(){
+  head = 0;
+  tail = 0;
+  running = false;
+  outputs = 0;
+};
+
+bool StepScheduler::push(Edge edge){
+  if(full()){
+    return false;
+  }
+  edges[head] = edge;
+  // the edge must be written before it is published to the timer interrupt
+  __sync_synchronize();
+  head = (head + 1) % SCHEDULE_SIZE;
+
+  // the interrupt stops the timer only when the ring buffer is empty, so it is restarted after the edge is published
+  if(!running){
+    startTimer();
+  }
+  return true;
+};
+
+bool StepScheduler::full(){
+  return (head + 1) % SCHEDULE_SIZE == tail;
+};
+
+bool StepScheduler::idle(){
+  return head == tail && !running;
+};
+
+unsigned long StepScheduler::interrupt(){
+  if(head == tail){
+    running = false;
+    return 0;
+  }
+  Edge edge = edges[tail];
+  tail = (tail + 1) % SCHEDULE_SIZE;
+
+  outputs = edge.outputs;
+  return edge.interval;
+};
+
+unsigned char StepScheduler::getOutputs(){
+  return outputs;
+};
+
+void StepScheduler::startTimer(){
+  running = true;
+};
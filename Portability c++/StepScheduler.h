@@ -0,0 +1,122 @@
+/*
+ * Header file for the StepScheduler class.
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STEPSCHEDULER_H
+#define STEPSCHEDULER_H
+
+#include "Config.h"
+
+// Number of edges of the ring buffer (a step pulse is made by two edges)
+#define SCHEDULE_SIZE 64
+
+// Longest interval (us) between two edges that the timer can count (a longer wait is split in more edges)
+#define MAX_INTERVAL 200000L
+
+// Outputs driven by the edges
+#define OUT_X_STP 0x01
+#define OUT_Y_STP 0x02
+#define OUT_X_DIR 0x04
+#define OUT_Y_DIR 0x08
+#define OUT_CNC 0x10
+#define OUT_MAGNET 0x20
+
+/**
+ * Edge variables
+ *
+ * outputs  : the levels of all the outputs (OUT_* bits) set by the timer interrupt
+ * interval : the time (us) from this edge to the next one, it is never 0
+ */
+struct Edge {
+    unsigned char outputs;
+    unsigned long interval;
+};
+
+class StepScheduler {
+    public:
+        /**
+         * Define the default constructor of the class
+         *
+         * - Return : an initialized instance of the class, with the ring buffer empty and the timer stopped
+         */
+        StepScheduler();
+
+        /**
+         * Append a precomputed edge to the ring buffer, starting the timer if it is stopped
+         * N.B.: only one producer can append edges, the timer interrupt is the only consumer
+         *
+         * - Parameters :
+         *      - edge : the edge to append
+         *
+         * - Return : false if the ring buffer is full (the edge is not appended)
+         */
+        bool push(Edge edge);
+
+        /**
+         * Verify if there is no room for another edge
+         *
+         * - Return : true if the ring buffer is full
+         */
+        bool full();
+
+        /**
+         * Verify if all the edges have been executed
+         *
+         * - Return : true if the ring buffer is empty and the timer is stopped
+         */
+        bool idle();
+
+        /**
+         * Body of the timer interrupt: set the outputs of the next edge and program the timer for the following
+         * one. The timer counts the interval from its own compare match, so the latency of the interrupt
+         * delays a single edge and it does not accumulate along the movement
+         *
+         * - Return : the interval (us) programmed in the timer, 0 if the ring buffer is empty and the timer
+         *            has been stopped
+         */
+        unsigned long interrupt();
+
+        /**
+         * Get the outputs set by the last executed edge
+         *
+         * - Return : the levels of the outputs (OUT_* bits)
+         */
+        unsigned char getOutputs();
+
+    private:
+        /**
+         * Start the timer, so that the first edge is executed as soon as possible
+         */
+        void startTimer();
+
+        /**
+         * Private variables
+         *
+         * edges   : the ring buffer of the precomputed edges
+         * head    : the place of the next appended edge (written only by the producer)
+         * tail    : the place of the next executed edge (written only by the timer interrupt)
+         * running : indicates if the timer is counting toward the next edge
+         * outputs : the levels of the outputs set by the last executed edge
+         */
+        Edge edges[SCHEDULE_SIZE];
+        volatile unsigned char head;
+        volatile unsigned char tail;
+        volatile bool running;
+        volatile unsigned char outputs;
+};
+
+#endif
@@ -0,0 +1,113 @@
+/*
+ * Replay of a motion trace
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * The replay reads a trace recorded with "portability_c__ -t <file>" and drives the MotionPipeline again with
+ * the recorded blocks, one sequence at a time. For any sequence it reports the recorded and the replayed time,
+ * the idle time (the stepper motors are still: power up, relays, waits) and the switches of the relays, so a
+ * misplaced piece can be followed step by step and the motion of two versions can be compared:
+ *
+ *      make build/TraceReplay
+ *      build/TraceReplay <file>
+ */
+
+#include "Config.h"
+#include "MotionPipeline.h"
+#include "MotionTrace.h"
+#include <stdio.h>
+
+using namespace std;
+
+int main(int argc, char * argv[]){
+  MotionPipeline pipeline;
+  TraceRecord record;
+  int sequences = 0;
+  int mismatches = 0;
+  unsigned long totalRecorded = 0;
+  unsigned long totalReplayed = 0;
+  unsigned long totalIdle = 0;
+  // statistics of the current sequence
+  bool started = false;
+  unsigned long start = 0;
+  unsigned long moving = 0;
+  long steps = 0;
+  int magnetSwitches = 0;
+  int powerSwitches = 0;
+
+  if(argc != 2){
+    fprintf(stderr, "Usage: %s <trace file>\n", argv[0]);
+    return 1;
+  }
+  FILE * file = fopen(argv[1], "rb");
+  if(file == NULL || !MotionTrace::readHeader(file)){
+    fprintf(stderr, "%s is not a motion trace\n", argv[1]);
+    return 1;
+  }
+
+  while(MotionTrace::readRecord(file, &record)){
+    if(record.block.type != BLOCK_END){
+      if(!started){
+        started = true;
+        start = record.start;
+      }
+      if(record.block.type == BLOCK_MOVE){
+        moving += record.duration;
+        steps += record.block.count;
+      } else if(record.block.type == BLOCK_RELAY){
+        if(record.block.target == POWER_MAGNET){
+          magnetSwitches++;
+        } else {
+          powerSwitches++;
+        }
+      }
+      pipeline.push(record.block);
+      continue;
+    }
+
+    // the name of the block lives in the record, so the sequence is completed before reading the next one
+    pipeline.push(record.block);
+    while(!pipeline.idle()){
+      pipeline.pause();
+    }
+    sequences++;
+
+    unsigned long recorded = started ? (record.start - start) / 1000 : 0;
+    unsigned long idle = started ? (record.start - start - moving) / 1000 : 0;
+    unsigned long replayed = pipeline.getLastDuration();
+    printf("%d %s : recorded %lu ms, replayed %lu ms, idle %lu ms, %ld steps, %d relay switches (%d magnet, %d power)%s\n",
+           sequences, record.name, recorded, replayed, idle, steps, magnetSwitches + powerSwitches, magnetSwitches,
+           powerSwitches, recorded != replayed ? " MISMATCH" : "");
+    if(recorded != replayed){
+      mismatches++;
+    }
+    totalRecorded += recorded;
+    totalReplayed += replayed;
+    totalIdle += idle;
+
+    started = false;
+    moving = 0;
+    steps = 0;
+    magnetSwitches = 0;
+    powerSwitches = 0;
+  }
+  fclose(file);
+
+  printf("\n%d sequences : recorded %lu ms, replayed %lu ms, idle %lu ms, %d mismatches\n", sequences, totalRecorded,
+         totalReplayed, totalIdle, mismatches);
+  return mismatches > 0 ? 2 : 0;
+}
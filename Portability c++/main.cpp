@@ -15,54 +15,726 @@
 #include <stdio.h>
 #include <iostream>
 # include <queue>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
 #include "Config.h"
+#include "ByteCapture.h"
 #include "ChessBoard.h"
+#include "CommandParser.h"
+#include "CommandQueue.h"
+#include "CommandReader.h"
+#include "LatencyHistogram.h"
+#include "MoveFrame.h"
+#include "ParsedCommand.h"
 
 using namespace std;
 
-int main()
+// Commands framed by '#' as sent by the Bluetooth module, read from the master side of a pty (-1 = standard input)
+CommandReader reader;
+CommandParser parser;
+int bluetooth = -1;
+
+// Commands read and parsed by the input thread, waiting to be executed
+CommandQueue commands;
+
+// Bytes received from the pty, recorded to be replayed (-c)
+ByteCapture capture;
+
+// Stages of a command measured by the replay (-r)
+#define STAGE_INPUT 0
+#define STAGE_WAIT 1
+#define STAGE_PARSE 2
+#define STAGE_EXECUTE 3
+#define STAGE_MOTION 4
+#define STAGE_TOTAL 5
+#define STAGES 6
+const char * stageNames[STAGES] = {"input", "wait", "parse", "execute", "motion", "total"};
+
+// Largest number of command streams served by the event loop (-m, -u), each one bound to its own chessboard
+#define MAX_SESSIONS 16
+
+// Names of the outcomes of the commands, sent back on the stream of a session
+const char * outcomeNames[OUTCOMES] = {"PERFORMED", "INVALID", "AMBIGUOUS", "COMMAND", "UNREACHABLE"};
+
+/**
+ * Session variables
+ *
+ * fd         : the master side of a pty or a connection to the Unix socket, -1 if the session is free
+ * pty        : indicates if the stream is a pty (it is never closed)
+ * chessBoard : the chessboard driven by the stream, created for the first stream of the session
+ * reader     : frames the commands of the stream
+ * parser     : validates the commands while they arrive, against the position of the chessboard
+ * moves      : the moves of the position, used by the parser
+ * commands   : the number of commands executed
+ */
+struct Session {
+    int fd;
+    bool pty;
+    ChessBoard * chessBoard;
+    CommandReader reader;
+    CommandParser parser;
+    Move moves[MAX_MOVES];
+    int commands;
+};
+Session sessions[MAX_SESSIONS];
+
+// Verify (without blocking) if the input thread has read a new command
+bool commandArrived(){
+    return commands.available();
+}
+
+// Open a raw pty, returning its master side (non blocking) or -1
+int openPty(){
+    struct termios options;
+
+    int master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+        return -1;
+    }
+    // the slave stays open here too, so the pty lives between two writers
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if(slave < 0 || tcgetattr(slave, &options) != 0){
+        return -1;
+    }
+    cfmakeraw(&options);
+    tcsetattr(slave, TCSANOW, &options);
+    return master;
+}
+
+// Open a pty in place of the Bluetooth module: the speech source writes its commands on the slave side
+bool openBluetooth(){
+    bluetooth = openPty();
+    if(bluetooth < 0){
+        return false;
+    }
+    printf("\nBluetooth pty : %s\n", ptsname(bluetooth));
+    return true;
+}
+
+// Listen (without blocking) for the connections to a Unix socket, returning the socket or -1
+int openSocket(const char * path){
+    struct sockaddr_un address;
+
+    if(strlen(path) >= sizeof(address.sun_path)){
+        return -1;
+    }
+    int listener = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if(listener < 0){
+        return -1;
+    }
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strcpy(address.sun_path, path);
+    // the socket left by a previous run is replaced
+    unlink(path);
+    if(bind(listener, (struct sockaddr *) &address, sizeof(address)) != 0 || listen(listener, MAX_SESSIONS) != 0){
+        close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+// Wait for the next command on the pty, as fgets would do on the standard input
+void readBluetooth(char voice[]){
+    struct pollfd input = {bluetooth, POLLIN, 0};
+
+    while(!reader.next(voice)){
+        poll(&input, 1, -1);
+        reader.receiveFrom(bluetooth, false);
+    }
+    // the last word ends with a newline, as the lines of the standard input
+    strcat(voice, "\n");
+}
+
+// Parse a command, without the position: a binary frame is decoded, the hypotheses of the speech recognizer and the
+// words are split (it is called also by the input thread, so strtok is not used)
+void parse(const char * voice, ParsedCommand * command){
+    char separators[] = {HYPOTHESIS_SEPARATOR, '\r', '\n', '\0'};
+    char source[PARSED_COMMAND_SIZE + 1];
+    char * state;
+    int length = 0;
+
+    snprintf(command->text, PARSED_COMMAND_SIZE, "%s", voice);
+    command->numHypotheses = 0;
+    command->numWords = 0;
+
+    // a move already recognized by the phone arrives as a binary frame, that needs no tokenization
+    command->frame = MoveFrame::isFrame(command->text);
+    if(command->frame){
+        command->decoded = MoveFrame::decode(command->text, &command->piece, command->from, command->to, &command->promotion);
+        return;
+    }
+
+    // the hypotheses (es: PEDINA A E4|PEDINA A E5) are validated against the moves of the position first
+    strcpy(command->hypotheses, command->text);
+    for(char * h = strtok_r(command->hypotheses, separators, &state); h != NULL && command->numHypotheses < MAX_HYPOTHESES;
+        h = strtok_r(NULL, separators, &state)){
+        command->hypothesis[command->numHypotheses++] = h - command->hypotheses;
+    }
+
+    // if no hypothesis is a move, the first one is left to the parser of the words
+    if(command->numHypotheses > 1){
+        snprintf(source, sizeof(source), "%s\n", command->hypotheses + command->hypothesis[0]);
+    } else {
+        strcpy(source, command->text);
+    }
+    // the letters of a FEN string keep their case (uppercase for the white pieces, lowercase for the black ones)
+    bool keepCase = false;
+    for(char * w = strtok_r(source, " ", &state); w != NULL && command->numWords < MAX_WORDS; w = strtok_r(NULL, " ", &state)){
+        command->word[command->numWords++] = length;
+        for(; *w != '\0'; w++){
+            command->words[length++] = keepCase ? *w : toupper(*w);
+        }
+        command->words[length++] = '\0';
+        keepCase = keepCase || strcmp(command->words, "FEN") == 0;
+    }
+}
+
+// Execute a parsed command: a binary frame, a move (or the hypotheses of the speech recognizer) or a command of words
+void execute(ChessBoard & chessBoard, ParsedCommand & command){
+    std::queue<char *> wordsQueue;
+    char * hypotheses[MAX_HYPOTHESES];
+
+    if(command.frame){
+        if(command.decoded){
+            chessBoard.move(command.piece, command.from, command.to, command.promotion);
+        } else {
+            printf("\n\nInvalid frame! Try again!\n");
+        }
+        return;
+    }
+
+    // the command is validated against the moves of the position first, so that also the partial commands
+    // (es: E4, PRENDE D5) are performed
+    for(int i = 0; i < command.numHypotheses; i++){
+        hypotheses[i] = command.hypotheses + command.hypothesis[i];
+    }
+    if(chessBoard.move(hypotheses, command.numHypotheses)){
+        return;
+    }
+
+    for(int i = 0; i < command.numWords; i++){
+        wordsQueue.push(command.words + command.word[i]);
+    }
+    chessBoard.move(wordsQueue);
+}
+
+// Parse and execute a command read by the caller itself
+void execute(ChessBoard & chessBoard, char voice[]){
+    ParsedCommand command;
+
+    parse(voice, &command);
+    execute(chessBoard, command);
+}
+
+
+// Verify if a command ends the program (the line can end with a newline)
+bool isExit(const char * voice){
+    return strncmp(voice, "EXIT", 4) == 0 && strspn(voice + 4, "\r\n") == strlen(voice + 4);
+}
+
+// Read the commands from the standard input (or from the pty) in their own thread, so a command is read while the
+// previous one is being validated or its pieces are moving
+void * readCommands(void *){
+    char voice[PARSED_COMMAND_SIZE];
+    ParsedCommand command;
+
+    while(true){
+        if(bluetooth >= 0){
+            readBluetooth(voice);
+        } else if(fgets(voice, 256, stdin) == NULL){
+            // the end of the standard input ends the program as EXIT
+            strcpy(voice, "EXIT");
+        }
+        // the command is parsed here, so the executor only validates it against the position
+        parse(voice, &command);
+        // the queue is full: the next bytes wait in the stream until the executor takes a command
+        commands.push(command);
+        if(isExit(voice)){
+            return NULL;
+        }
+    }
+}
+
+// Current time (us), as the wall clock of the batch
+unsigned long long now(){
+    struct timespec clock;
+
+    clock_gettime(CLOCK_MONOTONIC, &clock);
+    return clock.tv_sec * 1000000ULL + clock.tv_nsec / 1000;
+}
+
+// Discard the messages of the moves and of the sequences, returning the standard output to restore (-1 on errors)
+int silence(){
+    fflush(stdout);
+    int console = dup(1);
+    int discard = open("/dev/null", O_WRONLY);
+    if(console < 0 || discard < 0 || dup2(discard, 1) < 0){
+        return -1;
+    }
+    close(discard);
+    return console;
+}
+
+// Print again on the standard output saved by silence
+void restore(int console){
+    fflush(stdout);
+    dup2(console, 1);
+    close(console);
+}
+
+// Execute all the commands of a file without prompts and report the throughput and the outcomes of the commands
+int runBatch(ChessBoard & chessBoard, FILE * input){
+    char voice[256];
+    int outcomes[OUTCOMES] = {0, 0, 0, 0, 0};
+    int commands = 0;
+
+    // the report is printed on the standard output
+    int console = silence();
+    if(console < 0){
+        return 1;
+    }
+
+    unsigned long long start = now();
+    while(fgets(voice, sizeof(voice), input) != NULL && !isExit(voice)){
+        if(strspn(voice, " \r\n") == strlen(voice)){
+            continue;
+        }
+        execute(chessBoard, voice);
+        outcomes[chessBoard.getOutcome()]++;
+        commands++;
+    }
+    unsigned long long elapsed = now() - start;
+    chessBoard.waitMotion();
+
+    restore(console);
+    printf("%d commands in %.3f ms (%.0f commands/s)\n", commands, elapsed / 1000.0,
+           elapsed > 0 ? commands * 1000000.0 / elapsed : 0.0);
+    printf("%d valid, %d invalid, %d ambiguous, %d unreachable, %d other commands\n", outcomes[OUTCOME_PERFORMED],
+           outcomes[OUTCOME_INVALID], outcomes[OUTCOME_AMBIGUOUS], outcomes[OUTCOME_UNREACHABLE], outcomes[OUTCOME_COMMAND]);
+    return 0;
+}
+
+// Replay the bytes of a capture through the reader, the parser, the chessboard and the simulated motion, at the
+// recorded times divided by speedUp (0 = without pauses), and report the latency percentiles of the stages of the
+// commands: input (from the first byte to the terminator), wait (the terminator is late because the previous
+// command was being executed, or the board is still moving the pieces of the previous command), parse (the reader and the parser on the bytes), execute (validation and planning),
+// motion (the time of the pieces, simulated) and total (from the first byte to the end of the motion)
+int runReplay(ChessBoard & chessBoard, FILE * input, double speedUp){
+    CaptureRecord record;
+    LatencyHistogram stages[STAGES];
+    Move moves[MAX_MOVES];
+    char voice[256];
+    int outcomes[OUTCOMES] = {0, 0, 0, 0, 0};
+    int commands = 0;
+    bool stopped = false;
+    // the command being received: the (scaled) time of its first byte and the time spent by the reader
+    bool receiving = false;
+    unsigned long long first = 0;
+    unsigned long long parsing = 0;
+    // the recorded time (us) when the board ends the motion of the last command executed
+    unsigned long long busyUntil = 0;
+
+    int console = silence();
+    if(console < 0){
+        return 1;
+    }
+
+    reader.setParser(&parser);
+    parser.reset(moves, chessBoard.legalMoves(moves), chessBoard.turn);
+    unsigned long long start = now();
+    while(!stopped && ByteCapture::readRecord(input, &record)){
+        // the bytes wait for their time, the ones received while a command was being executed are already late
+        unsigned long long due = speedUp > 0 ? start + (unsigned long long) (record.time / speedUp) : now();
+        if(due > now()){
+            usleep(due - now());
+        }
+
+        for(int i = 0; i < record.length && !stopped; i++){
+            int discarded = reader.getDiscarded();
+            if(!receiving && record.bytes[i] != '\r' && record.bytes[i] != '\n'){
+                receiving = true;
+                first = due;
+                parsing = 0;
+            }
+            unsigned long long received = now();
+            reader.receive(record.bytes[i]);
+            parsing += now() - received;
+            if(reader.getDiscarded() != discarded){
+                receiving = false;
+            }
+            if(!reader.next(voice)){
+                continue;
+            }
+
+            // the last word ends with a newline, as the lines of the standard input
+            strcat(voice, "\n");
+            if(isExit(voice)){
+                stopped = true;
+                break;
+            }
+            unsigned long long executed = now();
+            execute(chessBoard, voice);
+            unsigned long long latencies[STAGES];
+            latencies[STAGE_INPUT] = due - first;
+            latencies[STAGE_PARSE] = parsing;
+            latencies[STAGE_EXECUTE] = now() - executed;
+            chessBoard.waitMotion();
+            latencies[STAGE_MOTION] = chessBoard.getOutcome() == OUTCOME_PERFORMED ? chessBoard.getMotionDuration() * 1000ULL : 0;
+            // the simulated motion takes no time here, so the command waits for the board on the recorded times:
+            // it starts when its terminator arrives or when the motion of the previous command ends
+            unsigned long long begin = busyUntil > record.time ? busyUntil : record.time;
+            latencies[STAGE_WAIT] = (received > due ? received - due : 0) + begin - record.time;
+            busyUntil = begin + latencies[STAGE_EXECUTE] + latencies[STAGE_MOTION];
+            latencies[STAGE_TOTAL] = 0;
+            for(int s = 0; s < STAGE_TOTAL; s++){
+                latencies[STAGE_TOTAL] += latencies[s];
+            }
+            for(int s = 0; s < STAGES; s++){
+                stages[s].add(latencies[s]);
+            }
+            outcomes[chessBoard.getOutcome()]++;
+            commands++;
+            receiving = false;
+
+            // the next command is validated against the new position
+            if(reader.idle()){
+                parser.reset(moves, chessBoard.legalMoves(moves), chessBoard.turn);
+            }
+        }
+    }
+    unsigned long long elapsed = now() - start;
+    chessBoard.waitMotion();
+
+    restore(console);
+    printf("%d commands replayed in %.3f ms (speed up %g), %d discarded\n", commands, elapsed / 1000.0, speedUp,
+           reader.getDiscarded());
+    printf("%d valid, %d invalid, %d ambiguous, %d unreachable, %d other commands\n", outcomes[OUTCOME_PERFORMED],
+           outcomes[OUTCOME_INVALID], outcomes[OUTCOME_AMBIGUOUS], outcomes[OUTCOME_UNREACHABLE], outcomes[OUTCOME_COMMAND]);
+    printf("\n%-8s %12s %12s %12s %12s\n", "stage", "p50 (ms)", "p90 (ms)", "p99 (ms)", "max (ms)");
+    for(int s = 0; s < STAGES; s++){
+        printf("%-8s %12.3f %12.3f %12.3f %12.3f\n", stageNames[s], stages[s].getPercentile(50) / 1000.0,
+               stages[s].getPercentile(90) / 1000.0, stages[s].getPercentile(99) / 1000.0, stages[s].getMax() / 1000.0);
+    }
+    return 0;
+}
+
+// Bind a stream to a free session: its chessboard is created, or reset if it served a stream now closed
+int openSession(int poller, int fd, bool pty){
+    struct epoll_event event;
+
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        Session & session = sessions[i];
+        if(session.fd >= 0){
+            continue;
+        }
+        if(session.chessBoard == NULL){
+            session.chessBoard = new ChessBoard();
+        } else {
+            char reset[] = "RESET\n";
+            execute(*session.chessBoard, reset);
+        }
+        session.fd = fd;
+        session.pty = pty;
+        session.reader = CommandReader();
+        session.reader.setParser(&session.parser);
+        session.parser.reset(session.moves, session.chessBoard->legalMoves(session.moves), session.chessBoard->turn);
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        if(epoll_ctl(poller, EPOLL_CTL_ADD, fd, &event) != 0){
+            session.fd = -1;
+            return -1;
+        }
+        return i;
+    }
+    return -1;
+}
+
+// Send back a line on the stream of a session (es: the outcome of a command)
+void reply(Session & session, const char * line){
+    if(session.fd >= 0 && (write(session.fd, line, strlen(line)) < 0 || write(session.fd, "\n", 1) < 0)){
+        // nobody reads the replies of the stream: they are lost
+    }
+}
+
+// Execute the oldest command of a session and send back its outcome, a line on the console reports it
+void serveSession(int index, int console){
+    Session & session = sessions[index];
+    char voice[256];
+    char command[COMMAND_SIZE];
+    char piece, promotion;
+    char from[3], to[3];
+
+    if(!session.reader.next(voice)){
+        return;
+    }
+    // the command is tokenized by the execution: the console shows a copy (the move of a frame)
+    if(MoveFrame::isFrame(voice) && MoveFrame::decode(voice, &piece, from, to, &promotion)){
+        snprintf(command, sizeof(command), "%c %s %s", piece, from, to);
+    } else {
+        snprintf(command, sizeof(command), "%.*s", (int) strcspn(voice, "\r\n"), voice);
+    }
+    // the last word ends with a newline, as the lines of the standard input
+    strcat(voice, "\n");
+    unsigned long long start = now();
+    execute(*session.chessBoard, voice);
+    unsigned long long elapsed = now() - start;
+    session.commands++;
+
+    const char * outcome = outcomeNames[session.chessBoard->getOutcome()];
+    dprintf(console, "session %d : %s -> %s (%llu us)\n", index, command, outcome, elapsed);
+    reply(session, outcome);
+
+    // the next command is validated against the new position
+    if(session.reader.idle()){
+        session.parser.reset(session.moves, session.chessBoard->legalMoves(session.moves), session.chessBoard->turn);
+    }
+}
+
+// Serve many independent command streams, each one bound to its own chessboard, with a single event loop: ptys
+// (as many Bluetooth modules) and the connections to a Unix socket (es: stand-in devices). The sessions take turns,
+// one command each, so a stream that sends many commands cannot delay the other ones. EXIT on the standard input
+// ends the loop
+int runSessions(int ptys, const char * socketPath){
+    struct epoll_event events[MAX_SESSIONS + 2];
+    struct epoll_event event;
+    int listener = -1;
+    // the ids of the events that are not sessions
+    const unsigned int LISTENER = MAX_SESSIONS;
+    const unsigned int CONSOLE = MAX_SESSIONS + 1;
+
+    // the messages of the chessboards are discarded, the console prints a line for any command
+    int console = silence();
+    int poller = epoll_create1(0);
+    if(console < 0 || poller < 0){
+        return 1;
+    }
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        sessions[i].fd = -1;
+        sessions[i].chessBoard = NULL;
+        sessions[i].commands = 0;
+    }
+
+    for(int i = 0; i < ptys; i++){
+        int fd = openPty();
+        int index = fd >= 0 ? openSession(poller, fd, true) : -1;
+        if(index < 0){
+            dprintf(console, "Cannot open the pty of session %d\n", i);
+            return 1;
+        }
+        dprintf(console, "Session %d pty : %s\n", index, ptsname(fd));
+    }
+    if(socketPath != NULL){
+        listener = openSocket(socketPath);
+        event.events = EPOLLIN;
+        event.data.u32 = LISTENER;
+        if(listener < 0 || epoll_ctl(poller, EPOLL_CTL_ADD, listener, &event) != 0){
+            dprintf(console, "Cannot listen on %s\n", socketPath);
+            return 1;
+        }
+        dprintf(console, "Sessions socket : %s\n", socketPath);
+    }
+    event.events = EPOLLIN;
+    event.data.u32 = CONSOLE;
+    epoll_ctl(poller, EPOLL_CTL_ADD, 0, &event);
+
+    bool running = true;
+    while(running){
+        // the commands already framed are executed before waiting for new bytes
+        bool pending = false;
+        for(int i = 0; i < MAX_SESSIONS && !pending; i++){
+            pending = sessions[i].fd >= 0 && sessions[i].reader.available();
+        }
+        int numEvents = epoll_wait(poller, events, MAX_SESSIONS + 2, pending ? 0 : -1);
+
+        for(int e = 0; e < numEvents; e++){
+            unsigned int id = events[e].data.u32;
+            if(id == LISTENER){
+                int fd;
+                while((fd = accept4(listener, NULL, NULL, SOCK_NONBLOCK)) >= 0){
+                    int index = openSession(poller, fd, false);
+                    if(index < 0){
+                        dprintf(console, "Connection refused: %d sessions are open\n", MAX_SESSIONS);
+                        close(fd);
+                    } else {
+                        dprintf(console, "Session %d connected\n", index);
+                    }
+                }
+            } else if(id == CONSOLE){
+                char line[256];
+                int length = read(0, line, sizeof(line) - 1);
+                if(length <= 0){
+                    // without a console the loop runs until it is killed
+                    epoll_ctl(poller, EPOLL_CTL_DEL, 0, NULL);
+                } else {
+                    line[length] = '\0';
+                    running = strstr(line, "EXIT") == NULL;
+                }
+            } else {
+                Session & session = sessions[id];
+                // a command of the session is waiting: the bytes wait in the kernel (EPOLLIN is reported again)
+                // until it is served, so a burst of commands is not lost
+                if(session.reader.available()){
+                    continue;
+                }
+                int discarded = session.reader.getDiscarded();
+                int received = session.reader.receiveFrom(session.fd, true);
+                // a command discarded anyway (too long or a corrupted frame) has its reply, so the client does not
+                // wait for it: the reading stops at the first complete command, so the replies keep their order
+                for(; discarded < session.reader.getDiscarded(); discarded++){
+                    reply(session, "DISCARDED");
+                }
+                if(received < 0 && !session.pty){
+                    // the commands received before the end of the stream are executed, then the session is free
+                    while(session.reader.available()){
+                        serveSession(id, console);
+                    }
+                    epoll_ctl(poller, EPOLL_CTL_DEL, session.fd, NULL);
+                    close(session.fd);
+                    session.fd = -1;
+                    dprintf(console, "Session %d closed\n", id);
+                }
+            }
+        }
+
+        for(int i = 0; i < MAX_SESSIONS; i++){
+            if(sessions[i].fd >= 0){
+                serveSession(i, console);
+            }
+        }
+    }
+
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        if(sessions[i].chessBoard != NULL){
+            sessions[i].chessBoard->waitMotion();
+        }
+    }
+    if(listener >= 0){
+        close(listener);
+        unlink(socketPath);
+    }
+    restore(console);
+    for(int i = 0; i < MAX_SESSIONS; i++){
+        if(sessions[i].chessBoard != NULL){
+            printf("Session %d : %d commands, %d discarded\n", i, sessions[i].commands, sessions[i].reader.getDiscarded());
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char * argv[])
 {
     
-    ChessBoard chessBoard = ChessBoard(DigitalOut motorPins[]);
+    ChessBoard chessBoard = ChessBoard();
+    pthread_t input;
+
+    // -t <file>   : record the executed motions in a trace file
+    // -g <device> : stream the motions as G-code to a GRBL controller
+    // -p          : read the commands from a pty, framed as the ones of the Bluetooth module
+    // -b <file>   : execute the commands of a file (- for the standard input) without prompts and report the throughput
+    // -c <file>   : record the bytes received from the pty (-p) with their time
+    // -r <file>   : replay a capture recorded with -c and report the latencies of the commands
+    // -x <factor> : speed up of the replay (1 = the recorded times, 0 = without pauses)
+    // -m <n>      : serve n ptys, each one bound to its own chessboard, with a single event loop
+    // -u <path>   : serve the connections to a Unix socket in the same event loop, each one with its own chessboard
+    FILE * batch = NULL;
+    FILE * replay = NULL;
+    double speedUp = 1;
+    int ptys = 0;
+    const char * socketPath = NULL;
+    for(int i = 1; i < argc; i++){
+        if(strcmp(argv[i], "-t") == 0 && i + 1 < argc){
+            if(!chessBoard.traceMotion(argv[++i])){
+                printf("\nCannot create the trace file %s\n", argv[i]);
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-g") == 0 && i + 1 < argc){
+            if(!chessBoard.streamMotion(argv[++i])){
+                printf("\nCannot open the controller %s\n", argv[i]);
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-p") == 0){
+            if(!openBluetooth()){
+                printf("\nCannot open a pty\n");
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-b") == 0 && i + 1 < argc){
+            batch = strcmp(argv[++i], "-") == 0 ? stdin : fopen(argv[i], "r");
+            if(batch == NULL){
+                printf("\nCannot open the commands file %s\n", argv[i]);
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-c") == 0 && i + 1 < argc){
+            if(!capture.open(argv[++i])){
+                printf("\nCannot create the capture file %s\n", argv[i]);
+                return 1;
+            }
+            reader.setCapture(&capture);
+        } else if(strcmp(argv[i], "-r") == 0 && i + 1 < argc){
+            replay = fopen(argv[++i], "rb");
+            if(replay == NULL || !ByteCapture::readHeader(replay)){
+                printf("\n%s is not a capture\n", argv[i]);
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-x") == 0 && i + 1 < argc){
+            speedUp = atof(argv[++i]);
+        } else if(strcmp(argv[i], "-m") == 0 && i + 1 < argc){
+            ptys = atoi(argv[++i]);
+            if(ptys < 0 || ptys > MAX_SESSIONS){
+                printf("\nAt most %d sessions can be served\n", MAX_SESSIONS);
+                return 1;
+            }
+        } else if(strcmp(argv[i], "-u") == 0 && i + 1 < argc){
+            socketPath = argv[++i];
+        }
+    }
+
+    if(batch != NULL){
+        return runBatch(chessBoard, batch);
+    }
+    if(replay != NULL){
+        return runReplay(chessBoard, replay, speedUp);
+    }
+    if(ptys > 0 || socketPath != NULL){
+        return runSessions(ptys, socketPath);
+    }
     
     chessBoard.toString();
     
     printf("\n\nBenvenuto!");
+
+    // the commands are read by their own thread and executed here, in the order they have been read
+    if(pthread_create(&input, NULL, readCommands, NULL) != 0){
+        printf("\nCannot start the input thread\n");
+        return 1;
+    }
     
     while(true){
         // Speech to text auxiliary variables
-        char voice[256] = "";
-        std::queue<char *> wordsQueue;
+        ParsedCommand command;
         
         printf("\n\nEsprimi un comando (EXIT per uscire): ");
-        fgets(voice, 256, stdin);
+        fflush(stdout);
+
+        // while the player is thinking, move the solenoid toward the next likely source cell
+        chessBoard.drift(commandArrived);
+
+        commands.pop(&command);
         
-        if(strcmp(voice,"EXIT") == 1){
+        if(isExit(command.text)){
+            // the last move is completed before leaving
+            chessBoard.waitMotion();
             exit(0);
         }
         
-        if (strlen(voice) > 0){
-          char * temp = strtok(voice, " ");
-          
-          for(int i = 0; i < strlen(temp); i++){
-              temp[i] = toupper(temp[i]);
-          }
-          
-          wordsQueue.push(temp);
-          
-          while(temp != NULL){
-            temp = strtok(NULL," ");
-            
-            if(temp != NULL){
-                for(int i = 0; i < strlen(temp); i++){
-                    temp[i] = toupper(temp[i]);
-                }
-                wordsQueue.push(temp);
-            }
-          }
-        }
-        
-        chessBoard.move(wordsQueue);
+        execute(chessBoard, command);
     }
 }
 
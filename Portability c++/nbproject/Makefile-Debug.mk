@@ -37,13 +37,26 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 OBJECTFILES= \
 	${OBJECTDIR}/Bishop.o \
 	${OBJECTDIR}/BishopsManager.o \
+	${OBJECTDIR}/ByteCapture.o \
 	${OBJECTDIR}/Cell.o \
+	${OBJECTDIR}/CemeteryManager.o \
 	${OBJECTDIR}/ChessBoard.o \
+	${OBJECTDIR}/CommandParser.o \
+	${OBJECTDIR}/CommandQueue.o \
+	${OBJECTDIR}/CommandReader.o \
+	${OBJECTDIR}/GcodeStreamer.o \
 	${OBJECTDIR}/King.o \
 	${OBJECTDIR}/KingsManager.o \
 	${OBJECTDIR}/Knight.o \
 	${OBJECTDIR}/KnightsManager.o \
+	${OBJECTDIR}/LatencyHistogram.o \
 	${OBJECTDIR}/Manager.o \
+	${OBJECTDIR}/MotionEstimator.o \
+	${OBJECTDIR}/MotionPipeline.o \
+	${OBJECTDIR}/MotionTrace.o \
+	${OBJECTDIR}/MoveFrame.o \
+	${OBJECTDIR}/MoveGenerator.o \
+	${OBJECTDIR}/PathPlanner.o \
 	${OBJECTDIR}/Pawn.o \
 	${OBJECTDIR}/PawnsManager.o \
 	${OBJECTDIR}/Piece.o \
@@ -51,6 +64,12 @@ OBJECTFILES= \
 	${OBJECTDIR}/QueensManager.o \
 	${OBJECTDIR}/Rook.o \
 	${OBJECTDIR}/RooksManager.o \
+	${OBJECTDIR}/RouteTable.o \
+	${OBJECTDIR}/RouteTableData.o \
+	${OBJECTDIR}/SetupPlanner.o \
+	${OBJECTDIR}/SimulatedTimer.o \
+	${OBJECTDIR}/Simulator.o \
+	${OBJECTDIR}/StepScheduler.o \
 	${OBJECTDIR}/main.o
 
 
@@ -68,7 +87,7 @@ FFLAGS=
 ASFLAGS=
 
 # Link Libraries and Options
-LDLIBSOPTIONS=
+LDLIBSOPTIONS=-lpthread
 
 # Build Targets
 .build-conf: ${BUILD_SUBPROJECTS}
@@ -88,16 +107,46 @@ ${OBJECTDIR}/BishopsManager.o: BishopsManager.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/BishopsManager.o BishopsManager.cpp
 
+${OBJECTDIR}/ByteCapture.o: ByteCapture.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ByteCapture.o ByteCapture.cpp
+
 ${OBJECTDIR}/Cell.o: Cell.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Cell.o Cell.cpp
 
+${OBJECTDIR}/CemeteryManager.o: CemeteryManager.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CemeteryManager.o CemeteryManager.cpp
+
 ${OBJECTDIR}/ChessBoard.o: ChessBoard.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ChessBoard.o ChessBoard.cpp
 
+${OBJECTDIR}/CommandParser.o: CommandParser.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CommandParser.o CommandParser.cpp
+
+${OBJECTDIR}/CommandQueue.o: CommandQueue.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CommandQueue.o CommandQueue.cpp
+
+${OBJECTDIR}/CommandReader.o: CommandReader.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CommandReader.o CommandReader.cpp
+
+${OBJECTDIR}/GcodeStreamer.o: GcodeStreamer.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/GcodeStreamer.o GcodeStreamer.cpp
+
 ${OBJECTDIR}/King.o: King.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -118,11 +167,46 @@ ${OBJECTDIR}/KnightsManager.o: KnightsManager.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/KnightsManager.o KnightsManager.cpp
 
+${OBJECTDIR}/LatencyHistogram.o: LatencyHistogram.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/LatencyHistogram.o LatencyHistogram.cpp
+
 ${OBJECTDIR}/Manager.o: Manager.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Manager.o Manager.cpp
 
+${OBJECTDIR}/MotionEstimator.o: MotionEstimator.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/MotionEstimator.o MotionEstimator.cpp
+
+${OBJECTDIR}/MotionPipeline.o: MotionPipeline.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/MotionPipeline.o MotionPipeline.cpp
+
+${OBJECTDIR}/MotionTrace.o: MotionTrace.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/MotionTrace.o MotionTrace.cpp
+
+${OBJECTDIR}/MoveFrame.o: MoveFrame.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/MoveFrame.o MoveFrame.cpp
+
+${OBJECTDIR}/MoveGenerator.o: MoveGenerator.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/MoveGenerator.o MoveGenerator.cpp
+
+${OBJECTDIR}/PathPlanner.o: PathPlanner.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/PathPlanner.o PathPlanner.cpp
+
 ${OBJECTDIR}/Pawn.o: Pawn.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -158,6 +242,36 @@ ${OBJECTDIR}/RooksManager.o: RooksManager.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/RooksManager.o RooksManager.cpp
 
+${OBJECTDIR}/RouteTable.o: RouteTable.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/RouteTable.o RouteTable.cpp
+
+${OBJECTDIR}/RouteTableData.o: RouteTableData.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/RouteTableData.o RouteTableData.cpp
+
+${OBJECTDIR}/SetupPlanner.o: SetupPlanner.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/SetupPlanner.o SetupPlanner.cpp
+
+${OBJECTDIR}/SimulatedTimer.o: SimulatedTimer.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/SimulatedTimer.o SimulatedTimer.cpp
+
+${OBJECTDIR}/Simulator.o: Simulator.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Simulator.o Simulator.cpp
+
+${OBJECTDIR}/StepScheduler.o: StepScheduler.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StepScheduler.o StepScheduler.cpp
+
 ${OBJECTDIR}/main.o: main.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
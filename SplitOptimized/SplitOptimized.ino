@@ -1,12 +1,15 @@
 #include <SoftwareSerial.h>
 #include <QueueArray.h>
 
-boolean command = true;
-
 int rxPin = 3;
 int txPin = 2;
 SoftwareSerial BT(rxPin, txPin);
 
+// Command being received (the speech source ends any command with '#')
+#define VOICE_SIZE 256
+char voice[VOICE_SIZE] = "";
+int index = 0;
+
 void setup() {
   // put your setup code here, to run once:
   Serial.begin(9600);
@@ -15,57 +18,53 @@ void setup() {
 
 void loop(){
   // Speech to text auxiliary variables
-  boolean command = true;
-  int index = 0;
-  char voice[256]="";
   QueueArray <char *> queue;
+  boolean complete = false;
 
-  /* Speech recognition phase */
-  while(command){
-
-    // Check if there is an available byte to read
-    // Cycle waiting for a communication with the speech source
-    while (BT.available()){
-      // Delay added to make thing stable
-      delay(10);
-
-      // Conduct a serial read
-      char c = tolower(BT.read());
+  /* Speech recognition phase: the software serial buffers the bytes in its
+   * interrupt, so they are taken without waiting until the '#' terminator */
+  while (BT.available() && !complete){
+    // Conduct a serial read
+    char c = tolower(BT.read());
 
+    if (c == '#'){
+      complete = true;
+    } else if (index < VOICE_SIZE - 1){
       // Add the character read to the speech-to-text string
-      voice[index]=c;
-
-      // Set command to false in order to exit from the external cycle
-      // (communication with the speech source completed)
-      command = false;
-
+      voice[index] = c;
       index++;
     }
+  }
+
+  if (!complete){
+    return;
+  }
+  voice[index] = '\0';
+  index = 0;
 
-    /* Split phase: if the string obtained from the previous recognition phase
-    * is not a empty string, it is splitted in order to analyze the words contained in it
-    * and perform the player move.
-    * Each word of the string is stored inside the playerMove array of words (String).
-    */
-    if (strlen(voice) > 0){
-      char * temp = strtok(voice, " ");
-      queue.enqueue(temp);
+  /* Split phase: if the string obtained from the previous recognition phase
+  * is not a empty string, it is splitted in order to analyze the words contained in it
+  * and perform the player move.
+  * Each word of the string is stored inside the playerMove array of words (String).
+  */
+  if (strlen(voice) > 0){
+    char * temp = strtok(voice, " ");
+    queue.enqueue(temp);
 
-      while(temp != NULL){
-        temp = strtok(NULL," ");
+    while(temp != NULL){
+      temp = strtok(NULL," ");
 
-        if(temp != NULL){
-          queue.enqueue(temp);
-        }
+      if(temp != NULL){
+        queue.enqueue(temp);
       }
+    }
 
-      Serial.print("Number of items in the queue:  ");
-      Serial.println(queue.count());
-      Serial.println("List of the items:");
+    Serial.print("Number of items in the queue:  ");
+    Serial.println(queue.count());
+    Serial.println("List of the items:");
 
-      while(!queue.isEmpty()){
-        Serial.println(String(stack.dequeue()));
-      }
+    while(!queue.isEmpty()){
+      Serial.println(String(queue.dequeue()));
     }
   }
 }
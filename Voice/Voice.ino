@@ -7,6 +7,9 @@ SoftwareSerial BT(rxPin, txPin);
 
 String voice;
 
+// Indicates if the '#' terminator of the command has arrived
+boolean complete = false;
+
 int greenled = 7; //Connect To Pin #7
 
 int yellowled = 6; //Connect To Pin #6
@@ -38,23 +41,21 @@ void setup(){
 }
 
 void loop() {
-  //Check if there is an available byte to read
-  while (BT.available()){ 
-    //Delay added to make thing stable
-    delay(10);
-    
+  //Take the available bytes without waiting: the software serial buffers them in its interrupt
+  while (BT.available() && !complete){ 
     //Conduct a serial read
     char c = BT.read();
 
-    //Exit the loop when the # is detected after the word
+    //The command is complete when the # is detected after the word
     if (c == '#'){
-      break;
+      complete = true;
+    } else {
+      voice += c;
     }
-    voice += c;
-
   }
 
-  if (voice.length() > 0){
+  if (complete){
+    complete = false;
 
     voice.toLowerCase();
     
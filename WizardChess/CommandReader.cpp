@@ -0,0 +1,149 @@
+/*
+ * CommandReader class implementation
+ *
+ * Copyright (c) 2018 Davide Molinelli.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, version 3.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CommandReader.h"
+#include <string.h>
+#ifndef ARDUINO
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Constructor
+CommandReader::CommandReader(){
+  head = 0;
+  tail = 0;
+  length = 0;
+  dropping = false;
+  frameLength = 0;
+  discarded = 0;
+};
+
+void CommandReader::receive(char c){
+  if((unsigned char) c & FRAME_NEXT){
+    receiveFrame(c);
+    return;
+  }
+
+  if(c == COMMAND_TERMINATOR || c == '\n'){
+    if(dropping){
+      discarded++;
+    } else if(length > 0){
+      push(partial, length);
+    }
+    length = 0;
+    dropping = false;
+    return;
+  }
+
+  // the carriage return sent after the terminator by some speech sources is not part of a command
+  if(c == '\r' || dropping){
+    return;
+  }
+  if(length == COMMAND_SIZE - 1){
+    dropping = true;
+    return;
+  }
+  partial[length++] = c;
+};
+
+void CommandReader::receiveFrame(char c){
+  char piece;
+  char from[3];
+  char to[3];
+  char promotion;
+
+  if(((unsigned char) c & FRAME_MASK) == FRAME_START){
+    if(frameLength > 0){
+      // the previous frame has lost a byte
+      discarded++;
+    }
+    frame[0] = c;
+    frameLength = 1;
+    return;
+  }
+  if(frameLength == 0){
+    // the rest of a frame already discarded
+    return;
+  }
+
+  frame[frameLength++] = c;
+  if(frameLength == MOVE_FRAME_SIZE){
+    frameLength = 0;
+    if(MoveFrame::decode(frame, &piece, from, to, &promotion)){
+      push(frame, MOVE_FRAME_SIZE);
+    } else {
+      discarded++;
+    }
+  }
+};
+
+void CommandReader::push(const char * command, int length){
+  if(full()){
+    // the parser is late: the new command is lost, the waiting ones are kept in order
+    discarded++;
+    return;
+  }
+  memcpy(commands[head], command, length);
+  commands[head][length] = '\0';
+  head = (head + 1) % COMMAND_SLOTS;
+};
+
+bool CommandReader::next(char command[COMMAND_SIZE]){
+  if(head == tail){
+    return false;
+  }
+  strcpy(command, commands[tail]);
+  tail = (tail + 1) % COMMAND_SLOTS;
+  return true;
+};
+
+bool CommandReader::available(){
+  return head != tail;
+};
+
+bool CommandReader::full(){
+  return (head + 1) % COMMAND_SLOTS == tail;
+};
+
+#ifndef ARDUINO
+int CommandReader::receiveFrom(int fd){
+  char c;
+  int total = 0;
+
+  // a byte read when the ring is full could complete a command that would be lost
+  while(!full()){
+    int received = read(fd, &c, 1);
+    if(received > 0){
+      receive(c);
+      total++;
+    } else if(received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)){
+      return total;
+    } else {
+      // the end of the file, or EIO when the slave side of a pty has been closed
+      return total > 0 ? total : -1;
+    }
+  }
+  return total;
+};
+#endif
+
+int CommandReader::getDiscarded(){
+  return discarded;
+};
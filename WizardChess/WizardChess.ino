@@ -19,11 +19,16 @@
 #include <SoftwareSerial.h>
 #include <QueueArray.h>
 #include "Config.h"
+#include "CommandReader.h"
+#include "MoveFrame.h"
 //#include "ChessBoard.h"
 
 // Bluetooth: define software serial
 //SoftwareSerial BT(BT_RX, BT_TX);
 
+// Commands received via bluetooth, framed by the '#' terminator
+CommandReader reader;
+
 //ChessBoard chessBoard;
 
 void setup() {
@@ -58,67 +63,66 @@ void setup() {
   //chessBoard.toString();
   
   delay(1000);
+
+  Serial.println("Esprimere un comando : ");
+  Serial.println();
 }
 
 void loop(){
 
   // Speech to text auxiliary variables
-  bool command = true;
-  int index = 0;
-  char voice[256] = "";
+  char voice[COMMAND_SIZE];
   QueueArray <char *> wordsQueue;
 
   /*
    *  Speech recognition and speech-to-text translation phase
    *  Reading of the characters coming from the speech source and received
    *  via bluetooth communication.
-   *  The charachters are stored in the voice variable (String type).
+   *  The software serial keeps the received bytes in its own buffer (filled by
+   *  an interrupt), so they are taken all at once without waiting: the command
+   *  is complete only when its '#' terminator arrives. While the ring of the
+   *  commands is full the bytes are left in that buffer, so no command is lost.
   */
+  while (!reader.full() && BT.available()){
+    reader.receive(BT.read());
+  }
 
-  Serial.println("Esprimere un comando : ");
-  Serial.println();
-  
-  // Speech recognition phase
-  while(command){
-    // Check if there is an available byte to read
-    // Cycle waiting for a communication with the speech source
-    while (BT.available()){
-      // Delay added to make thing stable
-      delay(10);
-
-      // Conduct a serial read
-      char c = toupper(BT.read());
+  if (!reader.next(voice)){
+    // nothing to do until the terminator arrives
+    return;
+  }
 
-      // Add the character read to the speech-to-text string
-      voice[index] = c;
+  // a move already recognized by the phone arrives as a binary frame, that needs no tokenization
+  if (MoveFrame::isFrame(voice)){
+    char piece, promotion;
+    char from[3], to[3];
+    if (MoveFrame::decode(voice, &piece, from, to, &promotion)){
+      //chessBoard.move(piece, from, to, promotion);
+    }
 
-      // Set command to false in order to exit from the external cycle
-      // (communication with the speech source completed)
-      command = false;
+    Serial.println("Esprimere un comando : ");
+    Serial.println();
+    return;
+  }
 
-      index++;
-    }
+  /* Split phase: the command is splitted in order to analyze the words contained in it
+  * and perform the player move.
+  * Each word of the string is stored inside a queue of words.
+  */
+  for (int i = 0; voice[i] != '\0'; i++){
+    voice[i] = toupper(voice[i]);
+  }
 
-    /* Split phase: if the string obtained from the previous recognition phase
-    * is not a empty string, it is splitted in order to analyze the words contained in it
-    * and perform the player move.
-    * Each word of the string is stored inside a queue of words.
-    */
-    if (strlen(voice) > 0){
-      char * temp = strtok(voice, " ");
-      wordsQueue.enqueue(temp);
-
-      while(temp != NULL){
-        temp = strtok(NULL," ");
-
-        if(temp != NULL){
-          wordsQueue.enqueue(temp);
-        }
-      }
-    }
+  char * temp = strtok(voice, " ");
+  while(temp != NULL){
+    wordsQueue.enqueue(temp);
+    temp = strtok(NULL," ");
   }
 
   //chessBoard.move(wordsQueue);
 
   // else Serial.println("Unrecognized command. Please, try again!");
+
+  Serial.println("Esprimere un comando : ");
+  Serial.println();
 }